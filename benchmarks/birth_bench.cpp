@@ -0,0 +1,138 @@
+/*
+ * File: birth_bench.cpp
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+/**
+ * @brief Measures the time to birth and tear down a large model, and the resident memory it takes.
+ * Defaults to 1000 Nodes of 1000 Metrics, 1M Metrics in total.
+ *
+ * birth_bench [nodes] [metrics]
+ */
+
+#include "SparkplugHost.h"
+#include "mqtt/message.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+
+#define BENCH_GROUP "bench"
+
+/**
+ * @brief The resident set size of this process in kilobytes
+ *
+ * @return size_t
+ */
+static size_t residentKilobytes()
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+
+    while (std::getline(status, line))
+    {
+        if (line.compare(0, 6, "VmRSS:") == 0)
+        {
+            return strtoul(line.c_str() + 6, nullptr, 10);
+        }
+    }
+
+    return 0;
+}
+
+static mqtt::const_message_ptr birth(size_t node, size_t metrics)
+{
+    tahu::Payload payload;
+    memset(&payload, 0, sizeof(payload));
+    payload.has_timestamp = true;
+    payload.timestamp = get_current_timestamp();
+    payload.has_seq = true;
+    payload.seq = 0;
+
+    int64_t bdSeq = 0;
+    add_simple_metric(&payload, "bdSeq", false, 0, METRIC_DATA_TYPE_INT64, false, false, &bdSeq, sizeof(bdSeq));
+
+    char name[32];
+    for (size_t i = 0; i < metrics; i++)
+    {
+        int64_t value = i;
+        snprintf(name, sizeof(name), "metric%zu", i);
+        add_simple_metric(&payload, name, false, 0, METRIC_DATA_TYPE_INT64, false, false, &value, sizeof(value));
+    }
+
+    size_t length = 1024 + metrics * 64;
+    uint8_t *buffer = (uint8_t *)malloc(length);
+    size_t size = encode_payload(buffer, length, &payload);
+    mqtt::const_message_ptr message = mqtt::message::create("spBv1.0/" BENCH_GROUP "/NBIRTH/node" + std::to_string(node), buffer, size, 0, false);
+    free(buffer);
+    free_payload(&payload);
+    return message;
+}
+
+int main(int argc, char **argv)
+{
+    size_t nodes = argc > 1 ? strtoul(argv[1], nullptr, 10) : 1000;
+    size_t metrics = argc > 2 ? strtoul(argv[2], nullptr, 10) : 1000;
+
+    std::vector<mqtt::const_message_ptr> births;
+    births.reserve(nodes);
+    for (size_t node = 0; node < nodes; node++)
+    {
+        births.push_back(birth(node, metrics));
+    }
+
+    printf("%zu Nodes of %zu Metrics, %zu Metrics in total\n", nodes, metrics, nodes * metrics);
+
+    // Measured once the births are encoded, so only the model is counted
+    size_t baseline = residentKilobytes();
+
+    std::unique_ptr<SparkplugHost> host(new SparkplugHost("tcp://localhost:1883", "birth_bench"));
+    std::set<std::string> rebirths;
+
+    auto start = std::chrono::steady_clock::now();
+    host->inject(births, rebirths);
+    std::chrono::duration<double> birthTime = std::chrono::steady_clock::now() - start;
+
+    size_t birthed = residentKilobytes();
+
+    start = std::chrono::steady_clock::now();
+    host.reset();
+    std::chrono::duration<double> teardownTime = std::chrono::steady_clock::now() - start;
+
+    size_t tornDown = residentKilobytes();
+
+    printf("birth:    %.3fs, %.0f Metrics/s\n", birthTime.count(), nodes * metrics / birthTime.count());
+    printf("teardown: %.3fs, %.0f Metrics/s\n", teardownTime.count(), nodes * metrics / teardownTime.count());
+    printf("rss:      %zu KB birthed, %.1f bytes per Metric, %zu KB retained after teardown\n",
+           birthed - baseline, (birthed - baseline) * 1024.0 / (nodes * metrics), tornDown > baseline ? tornDown - baseline : 0);
+
+    return 0;
+}
@@ -0,0 +1,141 @@
+/*
+ * File: drain_bench.cpp
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+/**
+ * @brief Measures the throughput of the ingest path. Pre-encoded NDATA messages are decoded and applied to
+ * the model with batch sizes of 1, 32 and 256, reporting messages per second.
+ *
+ * drain_bench [nodes] [metrics] [messages]
+ */
+
+#include "SparkplugHost.h"
+#include "mqtt/message.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#define BENCH_GROUP "bench"
+
+static mqtt::const_message_ptr encode(const std::string &topic, tahu::Payload *payload)
+{
+    size_t length = 64 * 1024;
+    uint8_t *buffer = (uint8_t *)malloc(length);
+    size_t size = encode_payload(buffer, length, payload);
+    mqtt::const_message_ptr message = mqtt::message::create(topic, buffer, size, 0, false);
+    free(buffer);
+    free_payload(payload);
+    return message;
+}
+
+static mqtt::const_message_ptr build(size_t node, size_t metrics, uint64_t seq, int64_t value, bool birth)
+{
+    tahu::Payload payload;
+    memset(&payload, 0, sizeof(payload));
+    payload.has_timestamp = true;
+    payload.timestamp = get_current_timestamp();
+    payload.has_seq = true;
+    payload.seq = seq;
+
+    if (birth)
+    {
+        int64_t bdSeq = 0;
+        add_simple_metric(&payload, "bdSeq", false, 0, METRIC_DATA_TYPE_INT64, false, false, &bdSeq, sizeof(bdSeq));
+    }
+
+    char name[32];
+    for (size_t i = 0; i < metrics; i++)
+    {
+        int64_t metricValue = value + i;
+        snprintf(name, sizeof(name), "metric%zu", i);
+        add_simple_metric(&payload, name, false, 0, METRIC_DATA_TYPE_INT64, false, false, &metricValue, sizeof(metricValue));
+    }
+
+    return encode("spBv1.0/" BENCH_GROUP + std::string(birth ? "/NBIRTH/" : "/NDATA/") + "node" + std::to_string(node), &payload);
+}
+
+static void discard(SparkplugHost &host)
+{
+    for (auto &update : host.getPayloads())
+    {
+        if (update.payload)
+        {
+            free_payload(update.payload);
+            free(update.payload);
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    size_t nodes = argc > 1 ? strtoul(argv[1], nullptr, 10) : 64;
+    size_t metrics = argc > 2 ? strtoul(argv[2], nullptr, 10) : 20;
+    size_t count = argc > 3 ? strtoul(argv[3], nullptr, 10) : 200000;
+
+    std::vector<mqtt::const_message_ptr> births;
+    for (size_t node = 0; node < nodes; node++)
+    {
+        births.push_back(build(node, metrics, 0, 0, true));
+    }
+
+    // Round robin over the Nodes, each message changes every Metric of its Node
+    std::vector<mqtt::const_message_ptr> data;
+    data.reserve(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        size_t node = i % nodes;
+        uint64_t seq = (i / nodes + 1) % 256;
+        data.push_back(build(node, metrics, seq, i, false));
+    }
+
+    printf("%zu Nodes, %zu Metrics per message, %zu messages\n", nodes, metrics, count);
+
+    for (size_t batch : {1, 32, 256})
+    {
+        SparkplugHost host("tcp://localhost:1883", "drain_bench");
+        host.batch(batch);
+
+        std::set<std::string> rebirths;
+        host.inject(births, rebirths);
+        discard(host);
+
+        auto start = std::chrono::steady_clock::now();
+        size_t applied = host.inject(data, rebirths);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        discard(host);
+
+        printf("batch %4zu: %.3fs, %.0f messages/s, %zu rebirths\n",
+               batch, elapsed.count(), applied / elapsed.count(), rebirths.size());
+    }
+
+    return 0;
+}
@@ -49,6 +49,37 @@ private:
     std::map<std::size_t, T *> items;
 
 protected:
+    /**
+     * @brief Constructs new items for the collection.
+     * Items are constructed using only their name if no factory is set.
+     *
+     */
+    std::function<T *(std::string &)> factory;
+
+    /**
+     * @brief Destroys items removed from the collection.
+     * Items are deleted if no destroy function is set, it must match the factory.
+     *
+     */
+    std::function<void(T *)> destroy;
+
+    /**
+     * @brief Destroys an item using the destroy function if one is set
+     *
+     * @param item
+     */
+    void release(T *item)
+    {
+        if (destroy)
+        {
+            destroy(item);
+        }
+        else
+        {
+            delete item;
+        }
+    }
+
     /**
      * @brief Perform an action on each item in the collection
      *
@@ -104,7 +135,7 @@ public:
         auto key = hasher(name);
         if (!items.contains(key))
         {
-            items[key] = new T(name);
+            items[key] = factory ? factory(name) : new T(name);
         }
 
         return items[key];
@@ -123,14 +154,48 @@ public:
         return get(input);
     }
 
+    /**
+     * @brief Finds the item in the collection that matches the name
+     * Unlike get, no item will be constructed if it doesn't exist
+     *
+     * @param name
+     * @return T* The item, or nullptr if no item matches the name
+     */
+    T *find(const std::string &name)
+    {
+        std::hash<std::string> hasher;
+        auto item = items.find(hasher(name));
+        return item != items.end() ? item->second : nullptr;
+    }
+
+    /**
+     * @brief Removes and destroys every item in the collection that matches a condition
+     *
+     * @param condition
+     */
+    void remove(std::function<bool(T *)> condition)
+    {
+        std::erase_if(
+            items,
+            [this, &condition](const std::pair<const long unsigned int, T *> &item)
+            {
+                if (!condition(item.second))
+                {
+                    return false;
+                }
+                release(item.second);
+                return true;
+            });
+    }
+
     /**
      * @brief Empties the collection of items
      *
      */
     void clear()
     {
-        each([](T *item)
-             { delete item; });
+        each([this](T *item)
+             { release(item); });
         items.clear();
     }
 
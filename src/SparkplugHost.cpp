@@ -33,9 +33,11 @@
 #include "SparkplugReceiver.h"
 #include "utilities/SparkplugTopic.h"
 #include "types/PublishableUpdate.h"
+#include "utilities/Snapshot.h"
 #include <thread>
 #include <chrono>
 #include <set>
+#include <algorithm>
 
 const string delimiter{"/"};
 const string SPARKPLUG_ID{"spBv1.0"};
@@ -55,35 +57,45 @@ int SparkplugHost::run()
 
     while (running)
     {
-        SparkplugMessage message;
-        SparkplugTopic topic;
         set<string> rebirths;
+        string snapshotDue;
+        bool backlogged = false;
 
         {
             lock_guard<mutex> guard(receiverLock);
 
+            // The snapshot settings are changed by persist() under the same lock
+            if (!snapshotPath.empty() && std::chrono::steady_clock::now() - lastSnapshot >= snapshotInterval)
+            {
+                snapshotDue = snapshotPath;
+                lastSnapshot = std::chrono::steady_clock::now();
+            }
+
             SparkplugReceiver *receiver = getReceiver();
 
-            while (receiver->consume(message))
+            // Bounded so timeouts, rebirths and commands are still serviced while the client is backlogged
+            size_t batches = 0;
+            while (batches < MAX_DRAIN_BATCHES)
             {
-                if (topic.parse(message.topic))
+                maintain(receiver);
+
+                if (drain(receiver, rebirths) == 0)
                 {
-                    ParseResult result;
-                    {
-                        lock_guard<mutex> guard(payloadLock);
-                        result = process(topic, message.payload);
-                    }
-                    if (result == ParseResult::OUT_OF_SYNC)
-                    {
-                        LOGGER("Receieved a message out of sync\n");
-                        string rebirthTopic(SPARKPLUG_ID + "/" + topic.getGroup() + "/NCMD/" + topic.getNode());
-                        rebirths.insert(rebirthTopic);
-                    }
-                    free_payload(message.payload);
-                    free(message.payload);
+                    break;
                 }
+                batches++;
+            }
+            backlogged = batches == MAX_DRAIN_BATCHES;
+
+            {
+                lock_guard<mutex> guard(payloadLock);
+                expire();
+                context.now = steadyNow();
+                release(rebirths);
             }
 
+            sample();
+
             for (auto item = rebirths.begin(); item != rebirths.end(); ++item)
             {
                 receiver->rebirth(*item);
@@ -105,25 +117,355 @@ int SparkplugHost::run()
             }
         }
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        if (!snapshotDue.empty())
+        {
+            writeSnapshot(snapshotDue);
+        }
+
+        if (!backlogged)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
     }
 
     return 0;
 }
 
+void SparkplugHost::maintain(SparkplugReceiver *receiver)
+{
+    if (!cluster)
+    {
+        return;
+    }
+
+    if (cluster->heartbeat())
+    {
+        receiver->announce(cluster->getTopic(), CLUSTER_ONLINE);
+    }
+
+    if (cluster->expire())
+    {
+        rebalance(receiver);
+    }
+}
+
+size_t SparkplugHost::drain(SparkplugReceiver *receiver, set<string> &rebirths)
+{
+    mqtt::const_message_ptr mqttMessage;
+
+    size_t count = 0;
+    bool membership = false;
+
+    while (ingest.size() < lookaheadSize && receiver->receive(mqttMessage))
+    {
+        count++;
+
+        if (cluster && cluster->isMembership(mqttMessage->get_topic()))
+        {
+            membership |= cluster->update(mqttMessage->get_topic(), mqttMessage->get_payload_str());
+            continue;
+        }
+
+        ingest.push(mqttMessage, now());
+    }
+
+    if (membership)
+    {
+        rebalance(receiver);
+    }
+
+    return count + applyBatch(rebirths);
+}
+
+size_t SparkplugHost::inject(const std::vector<mqtt::const_message_ptr> &messages, std::set<std::string> &rebirths)
+{
+    lock_guard<mutex> guard(receiverLock);
+
+    size_t count = 0;
+    auto message = messages.begin();
+
+    while (message != messages.end() || ingest.size() > 0)
+    {
+        for (; message != messages.end() && ingest.size() < lookaheadSize; message++)
+        {
+            ingest.push(*message, now());
+        }
+
+        count += applyBatch(rebirths);
+    }
+
+    return count;
+}
+
+size_t SparkplugHost::applyBatch(set<string> &rebirths)
+{
+    received.clear();
+    receivedAt.clear();
+
+    IngestEntry entry;
+    size_t promoted = 0;
+
+    while (received.size() < batchSize && ingest.pop(entry))
+    {
+        promoted += entry.promoted;
+        received.push_back(entry.message);
+        receivedAt.push_back(entry.received);
+    }
+
+    if (promoted > 0)
+    {
+        context.statistics.add(&ModelStatistics::promotedMessages, promoted);
+    }
+
+    if (received.empty())
+    {
+        return 0;
+    }
+
+    if (!decodePool)
+    {
+        decodePool.reset(new DecodePool(decodeThreads));
+    }
+
+    if (cluster)
+    {
+        decodePool->decode(received, decoded, [this](SparkplugTopic &topic)
+                           { return owns(topic); });
+    }
+    else
+    {
+        decodePool->decode(received, decoded);
+    }
+
+    pending.clear();
+
+    {
+        lock_guard<mutex> guard(payloadLock);
+
+        // Timers are scheduled relative to the wheel, so it's kept current before any are restarted
+        expire();
+        context.now = steadyNow();
+
+        for (auto &item : decoded)
+        {
+            if (item.message.payload != nullptr)
+            {
+                pending.push_back({&item, resolve(item.topic), receivedAt[&item - decoded.data()]});
+            }
+        }
+
+        // Group messages by Node while keeping the arrival order of each Node's messages
+        stable_sort(
+            pending.begin(),
+            pending.end(),
+            [](const PendingMessage &a, const PendingMessage &b)
+            { return std::less<Node *>()(a.node, b.node); });
+
+        for (size_t i = 0; i < pending.size(); i++)
+        {
+            auto &entry = pending[i];
+            auto &message = entry.decoded->message;
+            auto &topic = entry.decoded->topic;
+
+            if (i + 1 < pending.size() && pending[i + 1].node != entry.node)
+            {
+                __builtin_prefetch(pending[i + 1].node);
+            }
+
+            ParseResult result = entry.node->process(topic, message.payload, entry.decoded->reader.get(), entry.received);
+
+            if (result == ParseResult::LIMITED)
+            {
+                // The Node holds on to the payload until its rate limit allows it
+                entry.node->defer(topic, message.payload, message.source, entry.received, std::move(entry.decoded->reader));
+                message.payload = nullptr;
+                message.source.reset();
+                continue;
+            }
+
+            if (result == ParseResult::OUT_OF_SYNC)
+            {
+                LOGGER("Receieved a message out of sync\n");
+                string rebirthTopic(SPARKPLUG_ID + "/" + topic.getGroup() + "/NCMD/" + topic.getNode());
+                if (rebirths.insert(rebirthTopic).second && entry.node->getStatistics())
+                {
+                    entry.node->getStatistics()->add(&ModelStatistics::rebirths, 1);
+                }
+            }
+
+            free_payload(message.payload);
+            free(message.payload);
+            message.payload = nullptr;
+            message.source.reset();
+            entry.decoded->reader.reset();
+        }
+
+        release(rebirths);
+        trackEvictions();
+    }
+
+    return received.size();
+}
+
+void SparkplugHost::trackEvictions()
+{
+    for (Publishable *publisher : context.evicted)
+    {
+        const std::string &source = publisher->getName();
+        Group *group = find(source.substr(0, source.find('/')));
+        if (group)
+        {
+            group->track(publisher);
+        }
+    }
+
+    context.evicted.clear();
+}
+
+void SparkplugHost::release(set<string> &rebirths)
+{
+    // Nodes that still have messages after their turn are queued again, so each gets one turn per call
+    for (size_t turns = context.deferred.size(); turns > 0 && !context.deferred.empty(); turns--)
+    {
+        Node *node = context.deferred.front();
+        context.deferred.pop_front();
+
+        if (node->release() == ParseResult::OUT_OF_SYNC)
+        {
+            LOGGER("Receieved a message out of sync\n");
+            const std::string &name = node->getName();
+            size_t separator = name.find('/');
+            string rebirthTopic(SPARKPLUG_ID + "/" + name.substr(0, separator) + "/NCMD/" + name.substr(separator + 1));
+            if (rebirths.insert(rebirthTopic).second && node->getStatistics())
+            {
+                node->getStatistics()->add(&ModelStatistics::rebirths, 1);
+            }
+        }
+    }
+}
+
+int64_t SparkplugHost::steadyNow()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int64_t SparkplugHost::now()
+{
+    return LatencyTracker::now();
+}
+
+bool SparkplugHost::owns(SparkplugTopic &topic)
+{
+    // Host STATE messages are handled by the receiver, everything else belongs to a Node
+    return cluster->owns(topic.getGroup(), topic.getNode());
+}
+
+void SparkplugHost::rebalance(SparkplugReceiver *receiver)
+{
+    LOGGER("Cluster membership changed, rebalancing\n");
+
+    receiver->subscribe(subscriptions());
+
+    lock_guard<mutex> guard(payloadLock);
+
+    remove([this](Group *group)
+           { return !cluster->owns(group->getName()); });
+
+    // Node names are prefixed with their Group
+    each([this](Group *group)
+         { group->remove([this, group](Node *node)
+                         { return !cluster->owns(group->getName(), node->getName().substr(group->getName().size() + 1)); }); });
+}
+
 void SparkplugHost::stop()
 {
     running = false;
     if (receiver)
     {
+        if (cluster)
+        {
+            receiver->announce(cluster->getTopic(), CLUSTER_OFFLINE);
+        }
         receiver->stop();
     }
 }
 
-ParseResult SparkplugHost::process(SparkplugTopic &topic, tahu::Payload *payload)
+void SparkplugHost::expire()
+{
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch());
+    context.timeouts.advance(elapsed.count() / STALE_TICK_MS, [this](TimerEntry *entry)
+                             {
+                                Publishable *publisher = (Publishable *)entry->owner;
+                                const std::string &source = publisher->getName();
+                                Group *group = find(source.substr(0, source.find('/')));
+                                if (group)
+                                {
+                                    group->expire(publisher);
+                                } });
+}
+
+void SparkplugHost::sample()
+{
+    auto now = std::chrono::steady_clock::now();
+    std::chrono::duration<double> elapsed = now - lastSample;
+
+    if (elapsed < std::chrono::seconds(1))
+    {
+        return;
+    }
+
+    lastSample = now;
+    double seconds = elapsed.count();
+
+    lock_guard<mutex> guard(payloadLock);
+    each([seconds](Group *group)
+         { group->sample(seconds); });
+    context.statistics.sample(seconds);
+}
+
+StatisticsSnapshot SparkplugHost::getStatistics()
+{
+    return context.statistics.read();
+}
+
+std::shared_ptr<const ModelStatistics> SparkplugHost::getStatistics(const std::string &group)
+{
+    lock_guard<mutex> guard(payloadLock);
+    Group *target = find(group);
+    return target ? target->getStatistics() : nullptr;
+}
+
+bool SparkplugHost::getLatency(const std::string &node, LatencyTracker &latency)
+{
+    lock_guard<mutex> guard(payloadLock);
+    Group *group = find(node.substr(0, node.find('/')));
+    Node *target = group ? group->find(node) : nullptr;
+
+    if (!target)
+    {
+        return false;
+    }
+
+    latency = target->getLatency();
+    return true;
+}
+
+vector<PublishableUpdate> SparkplugHost::getLatencyPayloads(bool force)
+{
+    vector<PublishableUpdate> payloads;
+    uint64_t timestamp = now() / 1000;
+
+    lock_guard<mutex> guard(payloadLock);
+    each([&payloads, force, timestamp](Group *group)
+         { group->appendLatency(payloads, force, timestamp); });
+
+    return payloads;
+}
+
+Node *SparkplugHost::resolve(SparkplugTopic &topic)
 {
     auto group = get(topic.getGroup());
-    return group->process(topic, payload);
+    return group->resolve(topic);
 }
 
 SparkplugReceiver *SparkplugHost::getReceiver()
@@ -138,9 +480,11 @@ SparkplugReceiver *SparkplugHost::getReceiver()
 
 void SparkplugHost::buildReceiver()
 {
+    // The model is kept between connections, Nodes that missed messages while disconnected
+    // fail their next sequence check and are rebirthed individually
+    if (!receiver)
     {
-        lock_guard<mutex> guard(payloadLock);
-        clear();
+        loadSnapshot();
     }
 
     if (receiver)
@@ -150,6 +494,7 @@ void SparkplugHost::buildReceiver()
 
     receiver.reset(new SparkplugReceiver(server, clientId, hostId));
     receiver->credentials(username, password);
+    receiver->subscribe(subscriptions());
     receiver->configure();
     receiver->activate();
 }
@@ -165,6 +510,229 @@ vector<PublishableUpdate> SparkplugHost::getPayloads(bool force)
     return payloads;
 }
 
+vector<PublishableUpdate> SparkplugHost::getSubscribedPayloads(int subscriber, bool force)
+{
+    vector<PublishableUpdate> payloads;
+    if (subscriber < 0 || subscriber >= MAX_METRIC_FILTERS)
+    {
+        return payloads;
+    }
+
+    uint64_t subscribers = (uint64_t)1 << subscriber;
+    {
+        lock_guard<mutex> guard(payloadLock);
+        each([&payloads, force, subscribers](Group *group)
+             { group->appendTo(payloads, force, subscribers); });
+    }
+    return payloads;
+}
+
+vector<PublishableUpdate> SparkplugHost::getChanges(uint64_t &cursor, int subscriber)
+{
+    vector<PublishableUpdate> payloads;
+    if (subscriber >= MAX_METRIC_FILTERS)
+    {
+        return payloads;
+    }
+
+    uint64_t subscribers = subscriber < 0 ? ALL_SUBSCRIBERS : (uint64_t)1 << subscriber;
+    uint64_t since = cursor;
+    {
+        lock_guard<mutex> guard(payloadLock);
+        each([&payloads, since, subscribers](Group *group)
+             { group->appendSince(payloads, since, subscribers); });
+        cursor = context.version;
+    }
+    return payloads;
+}
+
+/**
+ * @brief Converts a timeout to ticks of the inactivity timers, rounding up
+ *
+ */
+static uint32_t toTicks(std::chrono::milliseconds timeout)
+{
+    if (timeout.count() <= 0)
+    {
+        return 0;
+    }
+
+    return std::min<int64_t>((timeout.count() + STALE_TICK_MS - 1) / STALE_TICK_MS, UINT32_MAX);
+}
+
+void SparkplugHost::staleAfter(std::chrono::milliseconds timeout)
+{
+    lock_guard<mutex> guard(payloadLock);
+    context.defaultTimeout = toTicks(timeout);
+    context.timeoutRevision++;
+}
+
+void SparkplugHost::staleAfter(const std::string &publisher, std::chrono::milliseconds timeout)
+{
+    lock_guard<mutex> guard(payloadLock);
+    context.publisherTimeouts[publisher] = toTicks(timeout);
+    context.timeoutRevision++;
+}
+
+void SparkplugHost::limit(RateLimit limit)
+{
+    lock_guard<mutex> guard(payloadLock);
+    context.defaultLimit = limit;
+    context.limitRevision++;
+}
+
+void SparkplugHost::limit(const std::string &node, RateLimit limit)
+{
+    lock_guard<mutex> guard(payloadLock);
+    context.nodeLimits[node] = limit;
+    context.limitRevision++;
+}
+
+std::map<std::string, uint64_t> SparkplugHost::getLimitedNodes()
+{
+    std::map<std::string, uint64_t> nodes;
+
+    lock_guard<mutex> guard(payloadLock);
+
+    each([&nodes](Group *group)
+         { group->appendLimited(nodes); });
+
+    return nodes;
+}
+
+MetricHandle SparkplugHost::resolveMetric(const std::string &path)
+{
+    size_t nodeStart = path.find('/');
+    size_t deviceStart = nodeStart == string::npos ? string::npos : path.find('/', nodeStart + 1);
+    size_t metricStart = deviceStart == string::npos ? string::npos : path.find('/', deviceStart + 1);
+
+    if (metricStart == string::npos)
+    {
+        return MetricHandle();
+    }
+
+    std::string nodeName = path.substr(0, deviceStart);
+    std::string device = path.substr(deviceStart + 1, metricStart - deviceStart - 1);
+    std::string metricName = path.substr(metricStart + 1);
+
+    lock_guard<mutex> guard(payloadLock);
+
+    Group *group = find(path.substr(0, nodeStart));
+    Node *node = group ? group->find(nodeName) : nullptr;
+    if (!node)
+    {
+        return MetricHandle();
+    }
+
+    Publishable *publisher = node;
+    if (!device.empty())
+    {
+        publisher = node->findDevice(device);
+    }
+
+    Metric *metric = publisher ? publisher->find(metricName) : nullptr;
+    return metric ? context.handles.bind(metric, publisher) : MetricHandle();
+}
+
+MetricReading SparkplugHost::read(MetricHandle handle)
+{
+    MetricReading reading;
+    lock_guard<mutex> guard(payloadLock);
+    context.handles.read(handle, reading);
+    return reading;
+}
+
+void SparkplugHost::read(std::span<const MetricHandle> handles, std::span<MetricReading> readings)
+{
+    size_t count = std::min(handles.size(), readings.size());
+    lock_guard<mutex> guard(payloadLock);
+    for (size_t i = 0; i < count; i++)
+    {
+        context.handles.read(handles[i], readings[i]);
+    }
+}
+
+int SparkplugHost::filter(std::string pattern, std::set<uint32_t> datatypes)
+{
+    lock_guard<mutex> guard(payloadLock);
+    int subscriber = context.filters.add(pattern, datatypes);
+    each([](Group *group)
+         { group->subscribe(); });
+    return subscriber;
+}
+
+void SparkplugHost::unfilter(int subscriber)
+{
+    lock_guard<mutex> guard(payloadLock);
+    context.filters.remove(subscriber);
+    each([](Group *group)
+         { group->subscribe(); });
+}
+
+void SparkplugHost::limitBytes(size_t perMetric, size_t total)
+{
+    lock_guard<mutex> guard(payloadLock);
+    context.bytes.limit(perMetric, total);
+    trackEvictions();
+}
+
+int SparkplugHost::deadband(std::string pattern, Deadband deadband, std::set<uint32_t> datatypes)
+{
+    lock_guard<mutex> guard(payloadLock);
+    int id = context.deadbands.add(pattern, deadband, datatypes);
+    each([](Group *group)
+         { group->subscribe(); });
+    return id;
+}
+
+void SparkplugHost::removeDeadband(int id)
+{
+    lock_guard<mutex> guard(payloadLock);
+    context.deadbands.remove(id);
+    each([](Group *group)
+         { group->subscribe(); });
+}
+
+void SparkplugHost::defaultDeadband(Deadband deadband)
+{
+    lock_guard<mutex> guard(payloadLock);
+    context.deadbands.setDefault(deadband);
+    each([](Group *group)
+         { group->subscribe(); });
+}
+
+int SparkplugHost::watchQuality(std::string pattern)
+{
+    lock_guard<mutex> guard(payloadLock);
+    int id = context.qualityWatches.add(pattern);
+    each([](Group *group)
+         { group->subscribe(); });
+    return id;
+}
+
+void SparkplugHost::unwatchQuality(int id)
+{
+    lock_guard<mutex> guard(payloadLock);
+    context.qualityWatches.remove(id);
+    each([](Group *group)
+         { group->subscribe(); });
+}
+
+vector<QualityChange> SparkplugHost::getQualityChanges()
+{
+    lock_guard<mutex> guard(payloadLock);
+    vector<QualityChange> changes(make_move_iterator(context.qualityChanges.begin()),
+                                  make_move_iterator(context.qualityChanges.end()));
+    context.qualityChanges.clear();
+    return changes;
+}
+
+void SparkplugHost::sendArrayChanges(bool enabled)
+{
+    lock_guard<mutex> guard(payloadLock);
+    context.arrayDeltas = enabled;
+}
+
 void SparkplugHost::command(SparkplugMessage message)
 {
     lock_guard<mutex> guard(commandLock);
@@ -174,16 +742,104 @@ void SparkplugHost::command(SparkplugMessage message)
 void SparkplugHost::configure(std::string address)
 {
     lock_guard<mutex> guard(receiverLock);
+    if (receiver && address == server)
+    {
+        return;
+    }
     this->server = address;
     buildReceiver();
 }
 
-SparkplugHost::SparkplugHost(std::string server, std::string clientId) : server(server), clientId(clientId)
+SparkplugHost::SparkplugHost(std::string server, std::string clientId) : SparkplugHost(server, clientId, "")
 {
 }
 
 SparkplugHost::SparkplugHost(std::string server, std::string clientId, std::string hostId) : server(server), clientId(clientId), hostId(hostId)
 {
+    factory = [this](std::string &name)
+    { return new Group(name, &context); };
+}
+
+SparkplugHost::~SparkplugHost()
+{
+    // Groups reference the context, so they must be released before it is
+    clear();
+}
+
+void SparkplugHost::persist(std::string path, std::chrono::milliseconds interval)
+{
+    lock_guard<mutex> guard(receiverLock);
+    snapshotPath = path;
+    snapshotInterval = interval;
+    lastSnapshot = std::chrono::steady_clock::now();
+}
+
+void SparkplugHost::writeSnapshot(const std::string &path)
+{
+    SnapshotWriter writer;
+    {
+        lock_guard<mutex> guard(payloadLock);
+        each([&writer](Group *group)
+             { group->snapshot(writer); });
+    }
+
+    if (!writer.write(path))
+    {
+        LOGGER("Failed to write a snapshot to %s\n", path.c_str());
+    }
+}
+
+void SparkplugHost::loadSnapshot()
+{
+    SnapshotReader reader;
+
+    if (snapshotPath.empty() || !reader.open(snapshotPath))
+    {
+        return;
+    }
+
+    SnapshotRecord record;
+    size_t restored = 0;
+
+    lock_guard<mutex> guard(payloadLock);
+    expire();
+
+    while (reader.next(record))
+    {
+        // Records are named group/node or group/node/device
+        size_t nodeStart = record.name.find(delimiter);
+        if (nodeStart == string::npos)
+        {
+            continue;
+        }
+        size_t deviceStart = record.name.find(delimiter, nodeStart + 1);
+
+        string group = record.name.substr(0, nodeStart);
+        string node = record.name.substr(nodeStart + 1, deviceStart == string::npos ? string::npos : deviceStart - nodeStart - 1);
+        string device = deviceStart == string::npos ? "" : record.name.substr(deviceStart + 1);
+
+        if (cluster && !cluster->owns(group, node))
+        {
+            continue;
+        }
+
+        tahu::Payload payload;
+        memset(&payload, 0, sizeof(payload));
+
+        if (decode_payload(&payload, record.payload, record.length) < 0)
+        {
+            LOGGER("Failed to restore %s from the snapshot\n", record.name.c_str());
+            free_payload(&payload);
+            continue;
+        }
+
+        get(group)->restore(node, device, &payload);
+        free_payload(&payload);
+        restored++;
+    }
+
+    trackEvictions();
+    LOGGER("Restored %zu Nodes and Devices from %s\n", restored, snapshotPath.c_str());
 }
 
 void SparkplugHost::credentials(std::string username, std::string password)
@@ -191,5 +847,103 @@ void SparkplugHost::credentials(std::string username, std::string password)
     lock_guard<mutex> guard(receiverLock);
     this->username = username;
     this->password = password;
-    buildReceiver();
+
+    if (!receiver)
+    {
+        buildReceiver();
+        return;
+    }
+
+    receiver->credentials(username, password);
+    receiver->reconnect();
+}
+
+void SparkplugHost::batch(size_t size)
+{
+    lock_guard<mutex> guard(receiverLock);
+    batchSize = size > 0 ? size : 1;
+}
+
+void SparkplugHost::lookahead(size_t size)
+{
+    lock_guard<mutex> guard(receiverLock);
+    lookaheadSize = size > 0 ? size : 1;
+}
+
+void SparkplugHost::decoders(size_t threads)
+{
+    lock_guard<mutex> guard(receiverLock);
+    decodeThreads = threads;
+    decodePool.reset();
+}
+
+std::set<std::string> SparkplugHost::subscriptions()
+{
+    std::set<std::string> topics;
+
+    if (cluster)
+    {
+        topics.insert(cluster->getFilter());
+
+        if (listening.empty())
+        {
+            // Groups aren't known ahead of time, so messages for other instances are dropped before decoding
+            topics.insert(SPARKPLUG_ID + "/#");
+        }
+    }
+
+    for (auto &[group, types] : listening)
+    {
+        if (cluster && !cluster->owns(group))
+        {
+            continue;
+        }
+
+        if (types.empty())
+        {
+            topics.insert(SPARKPLUG_ID + delimiter + group + "/#");
+            continue;
+        }
+
+        for (auto type : types)
+        {
+            auto &command = SparkplugTopic::getCommandName(type);
+            if (!command.empty())
+            {
+                topics.insert(SPARKPLUG_ID + delimiter + group + delimiter + command + "/#");
+            }
+        }
+    }
+
+    return topics;
+}
+
+void SparkplugHost::listen(std::string group, std::set<SparkplugCommandType> types)
+{
+    lock_guard<mutex> guard(receiverLock);
+    listening[group] = types;
+    if (receiver)
+    {
+        receiver->subscribe(subscriptions());
+    }
+}
+
+void SparkplugHost::join(std::string name, std::string instance, ClusterPartition partition, std::chrono::milliseconds heartbeat)
+{
+    lock_guard<mutex> guard(receiverLock);
+    cluster.reset(new Cluster(name, instance, partition, heartbeat));
+    if (receiver)
+    {
+        rebalance(receiver.get());
+    }
+}
+
+void SparkplugHost::unlisten(std::string group)
+{
+    lock_guard<mutex> guard(receiverLock);
+    listening.erase(group);
+    if (receiver)
+    {
+        receiver->subscribe(subscriptions());
+    }
 }
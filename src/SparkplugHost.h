@@ -34,11 +34,21 @@
 
 #include "MQTTAsync.h"
 #include "types/Group.h"
+#include "types/ModelContext.h"
 #include "DataCollection.h"
+#include "utilities/DecodePool.h"
+#include "utilities/IngestQueue.h"
+#include "utilities/Cluster.h"
 #include <functional>
 #include <map>
 #include <atomic>
 #include <memory>
+#include <vector>
+#include <set>
+#include <span>
+
+// The most batches drained in one cycle of run() before the timers, rebirths and commands are serviced
+#define MAX_DRAIN_BATCHES 256
 
 using namespace std;
 
@@ -61,8 +71,147 @@ private:
     mutex commandLock;
     mutex receiverLock;
     std::vector<SparkplugMessage> commands;
-    ParseResult process(SparkplugTopic &topic, tahu::Payload *payload);
     atomic<bool> running = false;
+    ModelContext context;
+    std::map<std::string, std::set<SparkplugCommandType>> listening;
+
+    /**
+     * @brief Builds the MQTT topic filters for the Groups being listened to
+     *
+     * @return std::set<std::string>
+     */
+    std::set<std::string> subscriptions();
+
+    /**
+     * @brief A decoded message waiting to be applied to the Node it targets
+     *
+     */
+    struct PendingMessage
+    {
+        DecodedMessage *decoded;
+        Node *node;
+        /**
+         * @brief When the message was taken from the client, in microseconds since the epoch
+         *
+         */
+        int64_t received;
+    };
+
+    size_t batchSize = 32;
+    size_t lookaheadSize = 4096;
+    IngestQueue ingest;
+    size_t decodeThreads = 0;
+    std::unique_ptr<DecodePool> decodePool;
+    std::vector<mqtt::const_message_ptr> received;
+    std::vector<int64_t> receivedAt;
+    std::vector<DecodedMessage> decoded;
+    std::vector<PendingMessage> pending;
+
+    /**
+     * @brief Resolves the Node a topic is targeting, creating it if it doesn't exist
+     *
+     * @param topic
+     * @return Node*
+     */
+    Node *resolve(SparkplugTopic &topic);
+    /**
+     * @brief Receives messages into the ingest queue, then applies a batch of messages from it.
+     * Lifecycle messages are taken ahead of data, messages for a Node are applied in the order they arrived.
+     *
+     * @param receiver
+     * @param rebirths Filled with the topics of Nodes that require a rebirth
+     * @return size_t The number of messages received from the client or taken from the ingest queue
+     */
+    size_t drain(SparkplugReceiver *receiver, std::set<std::string> &rebirths);
+    /**
+     * @brief Takes up to a batch of messages from the ingest queue, decodes all of them on the decode pool
+     * and applies them to the model grouped by Node
+     *
+     * @param rebirths Filled with the topics of Nodes that require a rebirth
+     * @return size_t The number of messages taken from the ingest queue
+     */
+    size_t applyBatch(std::set<std::string> &rebirths);
+    /**
+     * @brief Gets the current time in microseconds since the epoch
+     *
+     * @return int64_t
+     */
+    static int64_t now();
+
+    std::unique_ptr<Cluster> cluster;
+
+    /**
+     * @brief Whether this instance is responsible for the messages on a topic
+     *
+     * @param topic
+     * @return true
+     * @return false
+     */
+    bool owns(SparkplugTopic &topic);
+    /**
+     * @brief Publishes this instance's heartbeat when it is due and expires the members of the cluster whose
+     * heartbeats stopped. Called before every batch so a busy drain can't starve the cluster.
+     *
+     * @param receiver
+     */
+    void maintain(SparkplugReceiver *receiver);
+    /**
+     * @brief Updates the subscriptions and releases any Groups and Nodes no longer owned
+     * after the members of the cluster changed
+     *
+     * @param receiver
+     */
+    void rebalance(SparkplugReceiver *receiver);
+
+    std::string snapshotPath;
+    std::chrono::milliseconds snapshotInterval;
+    std::chrono::steady_clock::time_point lastSnapshot;
+
+    /**
+     * @brief Writes a snapshot of the model to a path
+     *
+     * @param path The snapshot path, copied under the receiverLock by the caller
+     */
+    void writeSnapshot(const std::string &path);
+    /**
+     * @brief Loads the model from the snapshot path, if a snapshot exists.
+     * Must be called while holding the receiverLock
+     *
+     */
+    void loadSnapshot();
+
+    /**
+     * @brief Advances the inactivity timers to the current time, staling the Nodes and Devices that timed out.
+     * The payload lock must be held.
+     *
+     */
+    void expire();
+    /**
+     * @brief Gives each Node with deferred messages a turn to apply what its rate limit allows.
+     * Requires the payload lock.
+     *
+     * @param rebirths Rebirth topics for Nodes whose deferred messages fell out of sync
+     */
+    void release(set<string> &rebirths);
+    /**
+     * @brief Tracks the versions of the Nodes and Devices whose Bytes were evicted, so cursors see the evictions.
+     * Requires the payload lock.
+     *
+     */
+    void trackEvictions();
+    /**
+     * @brief Gets the current time of the monotonic clock in microseconds, used for rate limits
+     *
+     * @return int64_t
+     */
+    static int64_t steadyNow();
+
+    std::chrono::steady_clock::time_point lastSample = std::chrono::steady_clock::now();
+    /**
+     * @brief Updates the message rates of the Groups and the Host once a second
+     *
+     */
+    void sample();
 
     std::unique_ptr<SparkplugReceiver> receiver;
     SparkplugReceiver *getReceiver();
@@ -84,6 +233,7 @@ public:
      * @param clientId
      */
     SparkplugHost(std::string server, std::string clientId, std::string hostId);
+    ~SparkplugHost();
     /**
      * @brief Blocking Control loop.
      * Connects to MQTT Server and starts consuming messages.
@@ -105,6 +255,253 @@ public:
      */
     vector<PublishableUpdate> getPayloads(bool force = false);
 
+    /**
+     * @brief Applies raw MQTT messages as if they were received from the client, through the ingest queue
+     * in batches of the configured size. Feeds the model without a broker, such as from a recording.
+     *
+     * @param messages
+     * @param rebirths Filled with the topics of Nodes that require a rebirth
+     * @return size_t The number of messages applied
+     */
+    size_t inject(const std::vector<mqtt::const_message_ptr> &messages, std::set<std::string> &rebirths);
+    /**
+     * @brief Returns a list of changes to the Metrics matching a subscriber's filter since the last time
+     * changes were retrieved. Changes are shared between subscribers, retrieving them clears them for all subscribers.
+     *
+     * @param subscriber The subscriber id returned when registering the filter
+     * @param force Forces the Sparkplug Host to return all data matching the filter
+     * @return vector<PublishableUpdate>
+     */
+    vector<PublishableUpdate> getSubscribedPayloads(int subscriber, bool force = false);
+    /**
+     * @brief Returns a list of changes made after a consumer's cursor, and moves the cursor to the current model version.
+     * Unlike getPayloads, changes are not acknowledged so any number of consumers can hold their own cursor.
+     * Changed Metrics are returned complete, and Nodes or Devices birthed after the cursor return all their Metrics.
+     *
+     * @param cursor The model version the consumer last read, 0 to read everything
+     * @param subscriber Only returns Metrics matching this subscriber's filter, or -1 for all Metrics
+     * @return vector<PublishableUpdate>
+     */
+    vector<PublishableUpdate> getChanges(uint64_t &cursor, int subscriber = -1);
+
+    /**
+     * @brief Resolves a handle to a Metric for point reads.
+     * Handles stay valid across births that keep the Metric, and are invalidated once the Metric is removed.
+     *
+     * @param path The path of the Metric in the form group/node/device/metric. Node Metrics have an empty device segment.
+     * @return MetricHandle The handle, unresolved if no Metric matches the path
+     */
+    MetricHandle resolveMetric(const std::string &path);
+    /**
+     * @brief Reads the value, timestamp and Quality of a Metric through its handle
+     *
+     * @param handle
+     * @return MetricReading The reading, not valid if the handle was invalidated
+     */
+    MetricReading read(MetricHandle handle);
+    /**
+     * @brief Reads several Metrics at once, consistent with each other
+     *
+     * @param handles
+     * @param readings Filled with a reading for each handle, must be at least as long as the handles
+     */
+    void read(std::span<const MetricHandle> handles, std::span<MetricReading> readings);
+
+    /**
+     * @brief Registers a Metric filter for a consumer.
+     * Filters are matched once when a Node or Device is birthed, Metrics matching no filters are no longer decoded.
+     * With no filters registered all Metrics are tracked.
+     *
+     * @param pattern A path pattern in the form group/node/device/metric, see MetricFilters
+     * @param datatypes The Metric datatypes to match. Matches all datatypes if empty.
+     * @return int The subscriber id of the filter, or -1 if no more filters can be registered
+     */
+    int filter(std::string pattern, std::set<uint32_t> datatypes = {});
+    /**
+     * @brief Removes a Metric filter
+     *
+     * @param subscriber The subscriber id returned when registering the filter
+     */
+    void unfilter(int subscriber);
+
+    /**
+     * @brief Limits the memory used to store Bytes and File Metrics.
+     * Values larger than the per Metric limit are dropped, and the least recently stored values are
+     * evicted once the total limit is reached. Dropped and evicted values are reported as null.
+     *
+     * @param perMetric The maximum size of a single value in bytes, 0 for no limit
+     * @param total The maximum size of all values in bytes, 0 for no limit
+     */
+    void limitBytes(size_t perMetric, size_t total);
+
+    /**
+     * @brief Registers a deadband for the Metrics matching a filter.
+     * Only new values outside the deadband of the last changed value flag a Metric as changed.
+     * When several filters match a Metric, the filter with the lowest id applies.
+     *
+     * @param pattern A path pattern in the form group/node/device/metric, see MetricFilters
+     * @param deadband
+     * @param datatypes The Metric datatypes to match. Matches all datatypes if empty.
+     * @return int The id of the deadband, or -1 if no more deadbands can be registered
+     */
+    int deadband(std::string pattern, Deadband deadband, std::set<uint32_t> datatypes = {});
+
+    /**
+     * @brief Removes a deadband registered with deadband()
+     *
+     * @param id
+     */
+    void removeDeadband(int id);
+
+    /**
+     * @brief Sets the deadband of Metrics that don't match any deadband filter.
+     * Defaults to exact comparison, so republished values that are unchanged don't flag a Metric.
+     *
+     * @param deadband
+     */
+    void defaultDeadband(Deadband deadband);
+
+    /**
+     * @brief Sets whether updates to array Metrics only include the changed elements.
+     * The changed elements are sent as a single range, with the index of its first element in the
+     * arrayOffset property. Births and full payloads always include every element.
+     *
+     * @param enabled
+     */
+    void sendArrayChanges(bool enabled);
+
+    /**
+     * @brief Sets how long Nodes and Devices can go without a message before they're marked as stale
+     * and reported as a death. Applies from each Node or Device's next message.
+     *
+     * @param timeout The timeout, rounded up to the resolution of STALE_TICK_MS. 0 disables the timeout.
+     */
+    void staleAfter(std::chrono::milliseconds timeout);
+    /**
+     * @brief Sets the inactivity timeout of a specific Node or Device, overriding the default timeout
+     *
+     * @param publisher The name of the Node (group/node) or Device (group/node/device)
+     * @param timeout The timeout, rounded up to the resolution of STALE_TICK_MS. 0 disables the timeout.
+     */
+    void staleAfter(const std::string &publisher, std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Reads the statistics of every Group without locking
+     *
+     * @return StatisticsSnapshot
+     */
+    StatisticsSnapshot getStatistics();
+    /**
+     * @brief Gets the statistics of a Group, which can then be read from any thread without locking.
+     * The statistics stop updating if the Group is released.
+     *
+     * @param group
+     * @return std::shared_ptr<const ModelStatistics> The statistics, or nullptr if the Group is unknown
+     */
+    std::shared_ptr<const ModelStatistics> getStatistics(const std::string &group);
+
+    /**
+     * @brief Copies the latencies of the messages from a Node and its Devices.
+     * Messages are received when the host takes them from the MQTT client, so time spent waiting
+     * in the client's queue is part of the transit time.
+     *
+     * @param node The name of the Node (group/node)
+     * @param latency Filled with the latencies of the Node
+     * @return true
+     * @return false The Node is unknown
+     */
+    bool getLatency(const std::string &node, LatencyTracker &latency);
+    /**
+     * @brief Returns a payload of latency Metrics for each Node that received messages since the last call.
+     * Each update is identified by the Node's name, see LatencyTracker::appendTo for the Metrics.
+     *
+     * @param force Returns a payload for every Node that has received messages
+     * @return vector<PublishableUpdate>
+     */
+    vector<PublishableUpdate> getLatencyPayloads(bool force = false);
+
+    /**
+     * @brief Sets the rate limit of every Node without a limit of its own.
+     * Births and deaths are never limited, data messages over the limit are handled by the limit's policy.
+     *
+     * @param limit
+     */
+    void limit(RateLimit limit);
+    /**
+     * @brief Sets the rate limit of a Node
+     *
+     * @param node The name of the Node in the form group/node
+     * @param limit
+     */
+    void limit(const std::string &node, RateLimit limit);
+    /**
+     * @brief Gets the Nodes that have sent data messages over their rate limit
+     *
+     * @return std::map<std::string, uint64_t> The number of limited messages of each Node, by group/node
+     */
+    std::map<std::string, uint64_t> getLimitedNodes();
+
+    /**
+     * @brief Reports changes to the Quality property of the Metrics matching a filter.
+     * Changes are collected with getQualityChanges().
+     *
+     * @param pattern A path pattern in the form group/node/device/metric, see MetricFilters
+     * @return int The id of the watch, or -1 if no more watches can be registered
+     */
+    int watchQuality(std::string pattern);
+
+    /**
+     * @brief Removes a watch registered with watchQuality()
+     *
+     * @param id
+     */
+    void unwatchQuality(int id);
+
+    /**
+     * @brief Collects the Quality changes of watched Metrics since the last call
+     *
+     * @return std::vector<QualityChange>
+     */
+    std::vector<QualityChange> getQualityChanges();
+
+    /**
+     * @brief Listens to a Group, subscribing only to its messages instead of all Sparkplug messages.
+     * Subscriptions are updated without reconnecting.
+     *
+     * @param group The Group to listen to
+     * @param types The message types to subscribe to (e.g. NBIRTH, NDATA). Subscribes to all types if empty.
+     */
+    void listen(std::string group, std::set<SparkplugCommandType> types = {});
+    /**
+     * @brief Stops listening to a Group. Listens to all Sparkplug messages once no Groups are listened to.
+     *
+     * @param group
+     */
+    void unlisten(std::string group);
+
+    /**
+     * @brief Joins a cluster of Sparkplug Hosts, splitting the Groups or Nodes on the network between the
+     * running instances. Each instance only decodes and tracks the partition it owns, partitions move to
+     * the remaining instances when an instance stops or its heartbeats are missed.
+     *
+     * @param name The name of the cluster, shared by all instances
+     * @param instance The unique id of this instance
+     * @param partition Whether Groups or Nodes are partitioned between instances
+     * @param heartbeat How often this instance announces itself to the cluster
+     */
+    void join(std::string name, std::string instance, ClusterPartition partition = ClusterPartition::NODE,
+              std::chrono::milliseconds heartbeat = std::chrono::seconds(5));
+
+    /**
+     * @brief Periodically writes a snapshot of the model to a file, and loads the model from it when connecting.
+     * Restored Nodes and Devices are reported as stale with their last known values straight away, and
+     * a rebirth is requested from each restored Node when its first message arrives.
+     *
+     * @param path The snapshot file
+     * @param interval How often the snapshot is written
+     */
+    void persist(std::string path, std::chrono::milliseconds interval = std::chrono::seconds(60));
+
     /**
      * @brief Publishes a metric to a topic
      *
@@ -114,19 +511,46 @@ public:
     void command(SparkplugMessage message);
 
     /**
-     * @brief Reconfigures the Host to connect to a new address
+     * @brief Reconfigures the Host to connect to a new address.
+     * The model is kept, only Nodes whose sequence is broken by the reconnect are rebirthed.
      *
      * @param address
      */
     void configure(std::string address);
 
     /**
-     * @brief Enables and sets the Username and Password for the MQTT connection
+     * @brief Enables and sets the Username and Password for the MQTT connection.
+     * An existing connection is reconnected in place with the new credentials, keeping the model.
+     * Nodes that published while disconnected fail their next sequence check and are rebirthed.
      *
      * @param username
      * @param password
      */
     void credentials(std::string username, std::string password);
+
+    /**
+     * @brief Sets the maximum number of messages received and decoded before
+     * they are applied to the model
+     *
+     * @param size
+     */
+    void batch(size_t size);
+
+    /**
+     * @brief Sets the maximum number of messages received ahead of the batch being applied.
+     * Births, deaths and Host STATE messages among them are applied first, so they don't wait behind a backlog of data.
+     *
+     * @param size
+     */
+    void lookahead(size_t size);
+
+    /**
+     * @brief Sets the number of threads used to decode received messages.
+     * With no threads messages are decoded on the control loop.
+     *
+     * @param threads
+     */
+    void decoders(size_t threads);
 };
 
 #endif /* SRC_SPARKPLUGHOST */
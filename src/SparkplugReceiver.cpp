@@ -34,6 +34,8 @@
 #include "mqtt/string_collection.h"
 #include <string>
 #include <chrono>
+#include <algorithm>
+#include <iterator>
 
 #define DEBUGGING 1
 #ifdef DEBUGGING
@@ -139,8 +141,22 @@ int SparkplugReceiver::configure()
     client.set_connected_handler(
         [this](const std::string &)
         {
-            std::vector<std::string> subscribeTopics = {SPARKPLUG_TOPIC};
-            mqtt::iasync_client::qos_collection subscribeQos{0};
+            std::vector<std::string> subscribeTopics;
+            mqtt::iasync_client::qos_collection subscribeQos;
+
+            {
+                lock_guard<mutex> guard(subscriptionLock);
+                if (topics.empty())
+                {
+                    subscribeTopics.push_back(SPARKPLUG_TOPIC);
+                    subscribeQos.push_back(QOS);
+                }
+                for (auto &topic : topics)
+                {
+                    subscribeTopics.push_back(topic);
+                    subscribeQos.push_back(QOS);
+                }
+            }
 
             if (!hostId.empty())
             {
@@ -159,44 +175,86 @@ int SparkplugReceiver::configure()
 
 bool SparkplugReceiver::consume(SparkplugMessage &message)
 {
-    if (client.is_connected())
+    mqtt::const_message_ptr mqttMessage;
+
+    while (receive(mqttMessage))
     {
-        mqtt::const_message_ptr mqttMessage;
-        if (client.try_consume_message(&mqttMessage))
+        if (decode(mqttMessage, message))
         {
-            if (mqttMessage->get_topic().compare(hostIdTopic) == 0)
-            {
-                auto json = mqttMessage->get_payload_str();
+            return true;
+        }
+    }
 
-                if (json.find("\"online\": false") != std::string::npos)
-                {
-                    client.publish(mqtt::message::create(hostIdTopic, hostIdOnline, 1, true));
-                }
+    return false;
+}
 
-                return false;
-            }
+bool SparkplugReceiver::receive(mqtt::const_message_ptr &message)
+{
+    if (!client.is_connected())
+    {
+        return false;
+    }
 
-            mqtt::binary payload = mqttMessage->get_payload();
+    while (client.try_consume_message(&message))
+    {
+        if (message->get_topic().compare(hostIdTopic) == 0)
+        {
+            auto json = message->get_payload_str();
 
-            // Decode the payload
-            tahu::Payload *sparkplugPayload = (tahu::Payload *)malloc(sizeof(tahu::Payload));
-            *sparkplugPayload = org_eclipse_tahu_protobuf_Payload_init_zero;
-            if (decode_payload(sparkplugPayload, (uint8_t *)payload.data(), payload.length()) < 0)
+            if (json.find("\"online\": false") != std::string::npos)
             {
-                free_payload(sparkplugPayload);
-                free(sparkplugPayload);
-                return false;
+                client.publish(mqtt::message::create(hostIdTopic, hostIdOnline, 1, true));
             }
 
-            message.payload = sparkplugPayload;
-            message.topic = mqttMessage->get_topic();
-            return true;
+            continue;
         }
+
+        return true;
     }
 
     return false;
 }
 
+bool SparkplugReceiver::decode(const mqtt::const_message_ptr &source, SparkplugMessage &message)
+{
+    const mqtt::binary &payload = source->get_payload();
+
+    // Decode the payload
+    tahu::Payload *sparkplugPayload = (tahu::Payload *)malloc(sizeof(tahu::Payload));
+    *sparkplugPayload = org_eclipse_tahu_protobuf_Payload_init_zero;
+    if (decode_payload(sparkplugPayload, (uint8_t *)payload.data(), payload.length()) < 0)
+    {
+        free_payload(sparkplugPayload);
+        free(sparkplugPayload);
+        return false;
+    }
+
+    message.payload = sparkplugPayload;
+    message.topic = source->get_topic();
+    return true;
+}
+
+bool SparkplugReceiver::decodeHeader(const mqtt::const_message_ptr &source, SparkplugMessage &message)
+{
+    const mqtt::binary &payload = source->get_payload();
+
+    tahu::Payload *sparkplugPayload = (tahu::Payload *)malloc(sizeof(tahu::Payload));
+    *sparkplugPayload = org_eclipse_tahu_protobuf_Payload_init_zero;
+
+    PayloadReader reader((const uint8_t *)payload.data(), payload.length());
+    if (!reader.header(sparkplugPayload))
+    {
+        free_payload(sparkplugPayload);
+        free(sparkplugPayload);
+        return false;
+    }
+
+    message.payload = sparkplugPayload;
+    message.topic = source->get_topic();
+    message.source = source;
+    return true;
+}
+
 #define NODE_CONTROL_REBIRTH_NAME "Node Control/Rebirth"
 #define DEVICE_CONTROL_REBIRTH_NAME "Device Control/Rebirth"
 
@@ -268,6 +326,17 @@ int SparkplugReceiver::command(SparkplugMessage &message)
     return 0;
 }
 
+int SparkplugReceiver::announce(const std::string &topic, const std::string &payload)
+{
+    if (!client.is_connected())
+    {
+        return -1;
+    }
+
+    client.publish(mqtt::message::create(topic, payload, QOS, false));
+    return 0;
+}
+
 void SparkplugReceiver::on_failure(const mqtt::token &asyncActionToken)
 {
 }
@@ -295,8 +364,57 @@ void SparkplugReceiver::stop()
     }
 }
 
+int SparkplugReceiver::reconnect()
+{
+    configure();
+
+    if (client.is_connected())
+    {
+        client.disconnect()->wait();
+    }
+
+    // The session is clean, the connected handler subscribes again. Messages that were already received
+    // remain queued as the consumer isn't restarted.
+    client.connect(connectionOptions);
+
+    return 0;
+}
+
 void SparkplugReceiver::credentials(std::string username, std::string password)
 {
     this->username = username;
     this->password = password;
 }
+
+void SparkplugReceiver::subscribe(const std::set<std::string> &topics)
+{
+    lock_guard<mutex> guard(subscriptionLock);
+
+    std::set<std::string> current = this->topics.empty() ? std::set<std::string>{SPARKPLUG_TOPIC} : this->topics;
+    std::set<std::string> next = topics.empty() ? std::set<std::string>{SPARKPLUG_TOPIC} : topics;
+
+    this->topics = topics;
+
+    if (!client.is_connected())
+    {
+        return;
+    }
+
+    std::vector<std::string> added;
+    std::vector<std::string> removed;
+
+    set_difference(next.begin(), next.end(), current.begin(), current.end(), back_inserter(added));
+    set_difference(current.begin(), current.end(), next.begin(), next.end(), back_inserter(removed));
+
+    // Subscribe before unsubscribing so overlapping filters don't drop messages
+    if (!added.empty())
+    {
+        mqtt::iasync_client::qos_collection subscribeQos(added.size(), QOS);
+        client.subscribe(mqtt::string_collection::create(added), subscribeQos);
+    }
+
+    if (!removed.empty())
+    {
+        client.unsubscribe(mqtt::string_collection::create(removed));
+    }
+}
@@ -35,7 +35,10 @@
 #include "mqtt/async_client.h"
 #include "types/TahuTypes.h"
 #include "utilities/SparkplugTopic.h"
+#include "utilities/PayloadReader.h"
 #include "mqtt/iaction_listener.h"
+#include <set>
+#include <mutex>
 
 using namespace std;
 
@@ -49,7 +52,12 @@ public:
     SparkplugMessage(){};
     SparkplugMessage(string topic, tahu::Payload *payload) : topic(topic), payload(payload){};
     string topic;
-    tahu::Payload *payload;
+    tahu::Payload *payload = nullptr;
+    /**
+     * @brief The raw message, kept when only the header of the payload has been decoded
+     *
+     */
+    mqtt::const_message_ptr source;
 };
 
 /**
@@ -70,6 +78,8 @@ private:
     std::string hostIdOffline;
     std::string hostIdOnline;
     uint64_t connectTime = 0;
+    std::mutex subscriptionLock;
+    std::set<std::string> topics;
     mqtt::ssl_options sslOptions;
     const mqtt::subscribe_options SUBSCRIBE_OPTIONS = mqtt::subscribe_options(
         mqtt::subscribe_options::SUBSCRIBE_NO_LOCAL,
@@ -126,6 +136,39 @@ public:
      */
     bool consume(SparkplugMessage &message);
 
+    /**
+     * @brief Attempts to receive a raw Sparkplug message from the MQTT Client without decoding it.
+     * Host STATE messages are handled by the receiver and are not returned.
+     *
+     * @param message A reference to a message pointer which will be filled with the received message
+     * @return true If a message was received
+     * @return false No message was received
+     */
+    bool receive(mqtt::const_message_ptr &message);
+
+    /**
+     * @brief Decodes a raw MQTT message into a Sparkplug message.
+     * The decoded payload is allocated and must be freed by the caller.
+     *
+     * @param source The raw MQTT message
+     * @param message A reference to a message which will be filled with data
+     * @return true If the payload was decoded
+     * @return false The payload could not be decoded
+     */
+    static bool decode(const mqtt::const_message_ptr &source, SparkplugMessage &message);
+
+    /**
+     * @brief Decodes only the header (timestamp, sequence) of a raw MQTT message into a Sparkplug message.
+     * The Metrics are left encoded in the raw message, which is kept on the Sparkplug message.
+     * The decoded payload is allocated and must be freed by the caller.
+     *
+     * @param source The raw MQTT message
+     * @param message A reference to a message which will be filled with data
+     * @return true If the header was decoded
+     * @return false The payload could not be decoded
+     */
+    static bool decodeHeader(const mqtt::const_message_ptr &source, SparkplugMessage &message);
+
     /**
      * @brief Publishes a Sparkplug payload with a Node Rebirth Metric
      *
@@ -148,6 +191,14 @@ public:
      * @return int
      */
     int command(SparkplugMessage &message);
+    /**
+     * @brief Publishes a plain text message to a topic
+     *
+     * @param topic
+     * @param payload
+     * @return int
+     */
+    int announce(const std::string &topic, const std::string &payload);
 
     /**
      * This method is invoked when an action fails.
@@ -167,6 +218,23 @@ public:
     void stop();
 
     void credentials(std::string username, std::string password);
+
+    /**
+     * @brief Reconnects the same client to the broker with the current credentials.
+     * Sparkplug requires Host Applications to connect with a clean session, so the broker drops the session
+     * and the subscriptions are issued again once connected. Messages published while disconnected are lost.
+     *
+     * @return int
+     */
+    int reconnect();
+
+    /**
+     * @brief Sets the Sparkplug topics the receiver subscribes to.
+     * When connected, only the changed subscriptions are subscribed/unsubscribed without reconnecting.
+     *
+     * @param topics The topic filters to subscribe to. Subscribes to all Sparkplug topics if empty.
+     */
+    void subscribe(const std::set<std::string> &topics);
 };
 
 #endif /* SRC_SPARKPLUGRECEIVER */
@@ -0,0 +1,412 @@
+/*
+ * File: ArrayValue.cpp
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#include "ArrayValue.h"
+#include <bit>
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+
+using namespace std;
+
+/**
+ * @brief Arrays are compared in blocks of this many bytes, only differing blocks are compared element by element.
+ * Fixed size comparisons are expanded into vector compares by the compiler.
+ *
+ */
+#define COMPARE_BLOCK 64
+
+/**
+ * @brief The bytes used to store an element of an array datatype, or 0 for String and unknown datatypes
+ *
+ */
+static size_t widthOf(uint32_t type)
+{
+    switch (type)
+    {
+    case METRIC_DATA_TYPE_INT8ARRAY:
+    case METRIC_DATA_TYPE_UINT8ARRAY:
+    case METRIC_DATA_TYPE_BOOLEANARRAY:
+        return sizeof(uint8_t);
+    case METRIC_DATA_TYPE_INT16ARRAY:
+    case METRIC_DATA_TYPE_UINT16ARRAY:
+        return sizeof(uint16_t);
+    case METRIC_DATA_TYPE_INT32ARRAY:
+    case METRIC_DATA_TYPE_UINT32ARRAY:
+    case METRIC_DATA_TYPE_FLOATARRAY:
+        return sizeof(uint32_t);
+    case METRIC_DATA_TYPE_INT64ARRAY:
+    case METRIC_DATA_TYPE_UINT64ARRAY:
+    case METRIC_DATA_TYPE_DOUBLEARRAY:
+    case METRIC_DATA_TYPE_DATETIMEARRAY:
+        return sizeof(uint64_t);
+    default:
+        return 0;
+    }
+}
+
+static inline bool sameBlock(const uint8_t *left, const uint8_t *right)
+{
+    return memcmp(left, right, COMPARE_BLOCK) == 0;
+}
+
+static inline void setBit(vector<uint64_t> &bits, size_t index)
+{
+    bits[index >> 6] |= (uint64_t)1 << (index & 63);
+}
+
+static inline bool getBit(const vector<uint64_t> &bits, size_t index)
+{
+    return (bits[index >> 6] >> (index & 63)) & 1;
+}
+
+/**
+ * @brief Converts elements between little endian and the host's byte order
+ *
+ */
+static void swapElements(uint8_t *bytes, size_t count, size_t width)
+{
+    if constexpr (endian::native == endian::little)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        reverse(bytes + i * width, bytes + (i + 1) * width);
+    }
+}
+
+ArrayValue::ArrayValue(uint32_t type, const bool *deltas) : type(type), width(widthOf(type)), deltas(deltas)
+{
+}
+
+void ArrayValue::decode(const pb_bytes_array_t *packed, ArrayValue &next)
+{
+    const uint8_t *bytes = packed ? packed->bytes : nullptr;
+    size_t length = packed ? packed->size : 0;
+
+    if (type == METRIC_DATA_TYPE_BOOLEANARRAY)
+    {
+        // Boolean arrays are a little endian element count followed by the elements packed most significant bit first
+        if (length < sizeof(uint32_t))
+        {
+            return;
+        }
+
+        uint32_t elements = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+        next.count = min<size_t>(elements, (length - sizeof(uint32_t)) * 8);
+        next.values.resize(next.count);
+
+        const uint8_t *bits = bytes + sizeof(uint32_t);
+        for (size_t i = 0; i < next.count; i++)
+        {
+            next.values[i] = (bits[i >> 3] >> (7 - (i & 7))) & 1;
+        }
+        return;
+    }
+
+    if (width == 0)
+    {
+        // String arrays are null terminated strings packed back to back
+        next.offsets.push_back(0);
+        for (size_t i = 0; i < length; i++)
+        {
+            if (bytes[i] == '\0')
+            {
+                next.offsets.push_back(next.characters.size());
+            }
+            else
+            {
+                next.characters.push_back(bytes[i]);
+            }
+        }
+
+        if (next.characters.size() != next.offsets.back())
+        {
+            next.offsets.push_back(next.characters.size());
+        }
+
+        next.count = next.offsets.size() - 1;
+        return;
+    }
+
+    next.count = length / width;
+    next.values.assign(bytes, bytes + next.count * width);
+    swapElements(next.values.data(), next.count, width);
+}
+
+bool ArrayValue::compare(ArrayValue &next)
+{
+    changed.resize((next.count + 63) >> 6, 0);
+
+    if (next.count != count)
+    {
+        fill(changed.begin(), changed.end(), 0);
+        for (size_t i = 0; i < next.count; i++)
+        {
+            setBit(changed, i);
+        }
+        dirty = true;
+        return true;
+    }
+
+    bool differs = false;
+
+    if (width == 0)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            if (getString(i) != next.getString(i))
+            {
+                setBit(changed, i);
+                differs = true;
+            }
+        }
+        dirty = dirty || differs;
+        return differs;
+    }
+
+    size_t length = count * width;
+    const uint8_t *current = values.data();
+    const uint8_t *incoming = next.values.data();
+
+    if (length == 0 || memcmp(current, incoming, length) == 0)
+    {
+        return false;
+    }
+
+    for (size_t offset = 0; offset < length; offset += COMPARE_BLOCK)
+    {
+        size_t span = min<size_t>(COMPARE_BLOCK, length - offset);
+
+        if (span == COMPARE_BLOCK ? sameBlock(current + offset, incoming + offset)
+                                  : memcmp(current + offset, incoming + offset, span) == 0)
+        {
+            continue;
+        }
+
+        for (size_t i = offset / width; i < (offset + span) / width; i++)
+        {
+            if (memcmp(current + i * width, incoming + i * width, width) != 0)
+            {
+                setBit(changed, i);
+                differs = true;
+            }
+        }
+    }
+
+    dirty = dirty || differs;
+    return differs;
+}
+
+bool ArrayValue::process(const pb_bytes_array_t *packed)
+{
+    size_t length = packed ? packed->size : 0;
+
+    // Fixed width elements are stored as received on little endian hosts, so republished arrays are
+    // matched against the packed bytes without decoding them
+    if constexpr (endian::native == endian::little)
+    {
+        if (width > 0 && type != METRIC_DATA_TYPE_BOOLEANARRAY && length / width == count &&
+            (count == 0 || memcmp(values.data(), packed->bytes, count * width) == 0))
+        {
+            return false;
+        }
+    }
+
+    ArrayValue next(type);
+    decode(packed, next);
+    bool differs = compare(next);
+
+    count = next.count;
+    values.swap(next.values);
+    offsets.swap(next.offsets);
+    characters.swap(next.characters);
+
+    return differs;
+}
+
+pb_bytes_array_t *ArrayValue::pack(size_t first, size_t last)
+{
+    size_t elements = last - first;
+    size_t length;
+
+    if (type == METRIC_DATA_TYPE_BOOLEANARRAY)
+    {
+        length = sizeof(uint32_t) + (elements + 7) / 8;
+    }
+    else if (width == 0)
+    {
+        length = offsets[last] - offsets[first] + elements;
+    }
+    else
+    {
+        length = elements * width;
+    }
+
+    pb_bytes_array_t *packed = (pb_bytes_array_t *)malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(length));
+    packed->size = length;
+    memset(packed->bytes, 0, length);
+
+    if (type == METRIC_DATA_TYPE_BOOLEANARRAY)
+    {
+        for (size_t i = 0; i < sizeof(uint32_t); i++)
+        {
+            packed->bytes[i] = (elements >> (i * 8)) & 0xFF;
+        }
+
+        uint8_t *bits = packed->bytes + sizeof(uint32_t);
+        for (size_t i = 0; i < elements; i++)
+        {
+            if (values[first + i])
+            {
+                bits[i >> 3] |= 0x80 >> (i & 7);
+            }
+        }
+    }
+    else if (width == 0)
+    {
+        uint8_t *target = packed->bytes;
+        for (size_t i = first; i < last; i++)
+        {
+            size_t size = offsets[i + 1] - offsets[i];
+            memcpy(target, characters.data() + offsets[i], size);
+            target += size + 1;
+        }
+    }
+    else if (length > 0)
+    {
+        memcpy(packed->bytes, values.data() + first * width, length);
+        swapElements(packed->bytes, elements, width);
+    }
+
+    return packed;
+}
+
+void ArrayValue::appendTo(tahu::Metric *metric, bool force)
+{
+    size_t first = 0;
+    size_t last = count;
+
+    if (!force && deltas && *deltas && dirty)
+    {
+        while (first < last && !getBit(changed, first))
+        {
+            first++;
+        }
+        while (last > first && !getBit(changed, last - 1))
+        {
+            last--;
+        }
+    }
+
+    // Unchanged arrays are still written in full
+    if (first == last)
+    {
+        first = 0;
+        last = count;
+    }
+
+    metric->which_value = org_eclipse_tahu_protobuf_Payload_Metric_bytes_value_tag;
+    metric->value.bytes_value = pack(first, last);
+
+    if (first > 0 || last < count)
+    {
+        uint32_t offset = first;
+        add_property_to_set(&metric->properties, ARRAY_OFFSET_PROPERTY, PROPERTY_DATA_TYPE_UINT32, &offset, sizeof(offset));
+        metric->has_properties = true;
+    }
+}
+
+void ArrayValue::acknowledge()
+{
+    fill(changed.begin(), changed.end(), 0);
+    dirty = false;
+}
+
+bool ArrayValue::isDirty()
+{
+    return dirty;
+}
+
+bool ArrayValue::isChanged(size_t index) const
+{
+    return index < count && getBit(changed, index);
+}
+
+vector<pair<size_t, size_t>> ArrayValue::getChanges() const
+{
+    vector<pair<size_t, size_t>> ranges;
+
+    if (!dirty)
+    {
+        return ranges;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (!getBit(changed, i))
+        {
+            continue;
+        }
+
+        if (!ranges.empty() && ranges.back().second == i)
+        {
+            ranges.back().second = i + 1;
+        }
+        else
+        {
+            ranges.emplace_back(i, i + 1);
+        }
+    }
+
+    return ranges;
+}
+
+size_t ArrayValue::size() const
+{
+    return count;
+}
+
+uint32_t ArrayValue::getType() const
+{
+    return type;
+}
+
+string_view ArrayValue::getString(size_t index) const
+{
+    if (width != 0 || index >= count)
+    {
+        return string_view();
+    }
+    return string_view(characters.data() + offsets[index], offsets[index + 1] - offsets[index]);
+}
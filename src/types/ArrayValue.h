@@ -0,0 +1,167 @@
+/*
+ * File: ArrayValue.h
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#ifndef SRC_TYPES_ARRAYVALUE
+#define SRC_TYPES_ARRAYVALUE
+
+#include "TahuTypes.h"
+#include "CommonTypes.h"
+#include <string_view>
+#include <vector>
+#include <utility>
+
+#define ARRAY_OFFSET_PROPERTY "arrayOffset"
+
+/**
+ * @brief The value of a Sparkplug array Metric (Int32Array, FloatArray, StringArray...).
+ * Elements are decoded from their packed form into a contiguous typed buffer, and compared with
+ * the previous elements so only the changed elements are flagged.
+ *
+ */
+class ArrayValue
+{
+private:
+    uint32_t type = METRIC_DATA_TYPE_UNKNOWN;
+    /**
+     * @brief Bytes per element, 0 for String arrays
+     *
+     */
+    size_t width = 0;
+    size_t count = 0;
+    std::vector<uint8_t> values;
+    /**
+     * @brief String elements share one buffer, element N spans offsets[N] to offsets[N + 1]
+     *
+     */
+    std::vector<uint32_t> offsets;
+    std::vector<char> characters;
+    /**
+     * @brief Bitmap of the elements changed since the changes were last acknowledged
+     *
+     */
+    std::vector<uint64_t> changed;
+    /**
+     * @brief New arrays are reported in full
+     *
+     */
+    bool dirty = true;
+    /**
+     * @brief Whether updates only include the changed elements, owned by the Host
+     *
+     */
+    const bool *deltas;
+
+    /**
+     * @brief Decodes packed elements into a new array of the same type
+     *
+     * @param packed
+     * @param next
+     */
+    void decode(const pb_bytes_array_t *packed, ArrayValue &next);
+    /**
+     * @brief Flags the elements of a newly decoded array that differ from this array
+     *
+     * @param next
+     * @return true Elements differ
+     * @return false
+     */
+    bool compare(ArrayValue &next);
+    /**
+     * @brief Packs a range of elements into a newly allocated bytes array
+     *
+     * @param first
+     * @param last One past the last element
+     * @return pb_bytes_array_t*
+     */
+    pb_bytes_array_t *pack(size_t first, size_t last);
+
+protected:
+public:
+    ArrayValue(uint32_t type, const bool *deltas = nullptr);
+    /**
+     * @brief Processes the packed elements of an array Metric. Flagged changes accumulate until they are acknowledged.
+     *
+     * @param packed
+     * @return true The elements differ from the previously processed array
+     * @return false The array was republished unchanged
+     */
+    bool process(const pb_bytes_array_t *packed);
+    /**
+     * @brief Writes the array to a tahu::Metric
+     *
+     * @param metric
+     * @param force Writes all elements. Otherwise when deltas are enabled only the range of changed elements
+     * is written, with the index of its first element as the arrayOffset property.
+     */
+    void appendTo(tahu::Metric *metric, bool force);
+    void acknowledge();
+    /**
+     * @brief Whether any elements changed since the changes were last acknowledged
+     *
+     * @return true
+     * @return false
+     */
+    bool isDirty();
+    bool isChanged(size_t index) const;
+    /**
+     * @brief Gets the ranges of changed elements
+     *
+     * @return std::vector<std::pair<size_t, size_t>> The first element and one past the last element of each range
+     */
+    std::vector<std::pair<size_t, size_t>> getChanges() const;
+    size_t size() const;
+    uint32_t getType() const;
+    /**
+     * @brief Gets the elements of a numeric or Boolean array without copying.
+     * Booleans are stored as uint8_t and DateTimes as uint64_t.
+     *
+     * @tparam T The element type of the array
+     * @return const T* The elements, or nullptr if the array isn't stored as T
+     */
+    template <typename T>
+    const T *data() const
+    {
+        if (width != sizeof(T))
+        {
+            return nullptr;
+        }
+        return reinterpret_cast<const T *>(values.data());
+    }
+    /**
+     * @brief Gets an element of a String array without copying
+     *
+     * @param index
+     * @return std::string_view
+     */
+    std::string_view getString(size_t index) const;
+};
+
+#endif /* SRC_TYPES_ARRAYVALUE */
@@ -0,0 +1,157 @@
+/*
+ * File: Bytes.cpp
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#include "Bytes.h"
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+
+#define DEBUGGING 1
+#ifdef DEBUGGING
+#define LOGGER(format, ...) \
+    printf("Bytes: ");      \
+    printf(format, ##__VA_ARGS__)
+#else
+#define LOGGER(out, ...)
+#endif
+
+StoredBytes::StoredBytes(BytesBudget *budget, std::function<void()> onEvicted) : budget(budget), onEvicted(onEvicted)
+{
+}
+
+StoredBytes::~StoredBytes()
+{
+    if (budget)
+    {
+        budget->release(this);
+    }
+}
+
+bool StoredBytes::take(pb_bytes_array_t *bytes)
+{
+    bool held = (bool)data;
+    bool differs = !held || bytes->size != data->size || memcmp(bytes->bytes, data->bytes, bytes->size) != 0;
+
+    if (budget)
+    {
+        budget->release(this);
+    }
+
+    data.reset(bytes, [](const pb_bytes_array_t *bytes)
+               { free((void *)bytes); });
+    evicted = false;
+
+    if (budget && !budget->admit(this))
+    {
+        LOGGER("Dropped %zu bytes exceeding the limits.\n", size());
+        data.reset();
+        evicted = true;
+    }
+
+    // Dropped and evicted bytes are reported as null, so only bytes that are still held compare their contents
+    return data ? differs : held;
+}
+
+std::shared_ptr<const pb_bytes_array_t> StoredBytes::view()
+{
+    return data;
+}
+
+bool StoredBytes::isEvicted()
+{
+    return evicted;
+}
+
+size_t StoredBytes::size()
+{
+    return data ? data->size : 0;
+}
+
+void BytesBudget::limit(size_t metricLimit, size_t totalLimit)
+{
+    this->metricLimit = metricLimit;
+    this->totalLimit = totalLimit;
+
+    evict(0);
+}
+
+bool BytesBudget::admit(StoredBytes *bytes)
+{
+    size_t size = bytes->size();
+
+    if ((metricLimit > 0 && size > metricLimit) || (totalLimit > 0 && size > totalLimit))
+    {
+        return false;
+    }
+
+    evict(size);
+
+    used += size;
+    bytes->accounted = size;
+    bytes->position = recent.insert(recent.begin(), bytes);
+    bytes->linked = true;
+    return true;
+}
+
+void BytesBudget::release(StoredBytes *bytes)
+{
+    if (!bytes->linked)
+    {
+        return;
+    }
+
+    recent.erase(bytes->position);
+    used -= bytes->accounted;
+    bytes->accounted = 0;
+    bytes->linked = false;
+}
+
+void BytesBudget::evict(size_t required)
+{
+    while (totalLimit > 0 && used + required > totalLimit && !recent.empty())
+    {
+        StoredBytes *victim = recent.back();
+        release(victim);
+        // Consumers holding a view keep the bytes alive, the value only drops its reference
+        victim->data.reset();
+        victim->evicted = true;
+
+        if (victim->onEvicted)
+        {
+            victim->onEvicted();
+        }
+    }
+}
+
+size_t BytesBudget::getUsed()
+{
+    return used;
+}
@@ -0,0 +1,153 @@
+/*
+ * File: Bytes.h
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#ifndef SRC_TYPES_BYTES
+#define SRC_TYPES_BYTES
+
+#include "pb.h"
+#include <memory>
+#include <list>
+#include <functional>
+
+class BytesBudget;
+
+/**
+ * @brief The value of a Bytes or File Metric.
+ * Takes ownership of the decoded bytes instead of copying them, and shares them with consumers
+ * through reference counted views. Bytes may be evicted by the budget to stay within its limits,
+ * views that are still held keep the bytes alive.
+ *
+ */
+class StoredBytes
+{
+private:
+    friend class BytesBudget;
+
+    std::shared_ptr<const pb_bytes_array_t> data;
+    BytesBudget *budget = nullptr;
+    std::list<StoredBytes *>::iterator position;
+    size_t accounted = 0;
+    bool linked = false;
+    bool evicted = false;
+    /**
+     * @brief Called when the budget evicts the bytes to make room for other values
+     *
+     */
+    std::function<void()> onEvicted;
+
+protected:
+public:
+    /**
+     * @brief Construct a new Stored Bytes value
+     *
+     * @param budget The budget the bytes are stored within, nullptr for no limits
+     * @param onEvicted Called when the budget evicts the bytes to make room for other values
+     */
+    StoredBytes(BytesBudget *budget, std::function<void()> onEvicted = nullptr);
+    ~StoredBytes();
+    StoredBytes(const StoredBytes &) = delete;
+    StoredBytes &operator=(const StoredBytes &) = delete;
+    /**
+     * @brief Takes ownership of decoded bytes, replacing the current bytes
+     *
+     * @param bytes The bytes, allocated with malloc. Freed once the value and all views release them.
+     * @return true The bytes differ from the bytes they replace. Dropped and evicted bytes compare as null.
+     * @return false
+     */
+    bool take(pb_bytes_array_t *bytes);
+    /**
+     * @brief Gets a view of the bytes without copying them
+     *
+     * @return std::shared_ptr<const pb_bytes_array_t> The bytes, or empty if they were evicted or dropped
+     */
+    std::shared_ptr<const pb_bytes_array_t> view();
+    /**
+     * @brief Whether the bytes were evicted or dropped for exceeding the budget
+     *
+     * @return true
+     * @return false
+     */
+    bool isEvicted();
+    size_t size();
+};
+
+/**
+ * @brief Limits the memory used by Bytes and File values.
+ * Values larger than the per Metric limit are dropped, and the least recently stored values are
+ * evicted when the total limit is reached. A limit of 0 is unlimited.
+ *
+ */
+class BytesBudget
+{
+private:
+    size_t metricLimit = 0;
+    size_t totalLimit = 0;
+    size_t used = 0;
+    /**
+     * @brief Stored values, the most recently stored first
+     *
+     */
+    std::list<StoredBytes *> recent;
+
+    /**
+     * @brief Evicts the least recently stored values until the budget has room for a number of bytes
+     *
+     * @param required
+     */
+    void evict(size_t required);
+
+protected:
+public:
+    /**
+     * @brief Sets the limits of the budget, evicting values if the budget is over its new total limit
+     *
+     * @param metricLimit The maximum bytes of a single value
+     * @param totalLimit The maximum bytes of all values
+     */
+    void limit(size_t metricLimit, size_t totalLimit);
+    /**
+     * @brief Accounts for a value, evicting other values if required
+     *
+     * @param bytes
+     * @return true
+     * @return false The value exceeds the limits and must be dropped
+     */
+    bool admit(StoredBytes *bytes);
+    /**
+     * @brief Stops accounting for a value
+     *
+     * @param bytes
+     */
+    void release(StoredBytes *bytes);
+    size_t getUsed();
+};
+
+#endif /* SRC_TYPES_BYTES */
@@ -36,7 +36,12 @@ enum class ParseResult
 {
     OK,
     OUT_OF_SYNC,
-    DO_NOTHING
+    DO_NOTHING,
+    /**
+     * @brief The message is over the Node's rate limit and must be handed to the Node to be applied later
+     *
+     */
+    LIMITED
 };
 
 #endif /* SRC_TYPES_COMMONTYPES */
@@ -0,0 +1,413 @@
+/*
+ * File: DataSet.cpp
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#include "DataSet.h"
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+
+using namespace std;
+
+/**
+ * @brief The bytes used to store a value of a fixed width datatype, or 0 for strings and unknown datatypes
+ *
+ */
+static size_t widthOf(uint32_t type)
+{
+    switch (type)
+    {
+    case DATA_SET_DATA_TYPE_INT8:
+    case DATA_SET_DATA_TYPE_INT16:
+    case DATA_SET_DATA_TYPE_INT32:
+    case DATA_SET_DATA_TYPE_UINT8:
+    case DATA_SET_DATA_TYPE_UINT16:
+    case DATA_SET_DATA_TYPE_UINT32:
+        return sizeof(uint32_t);
+    case DATA_SET_DATA_TYPE_INT64:
+    case DATA_SET_DATA_TYPE_UINT64:
+    case DATA_SET_DATA_TYPE_DATETIME:
+        return sizeof(uint64_t);
+    case DATA_SET_DATA_TYPE_FLOAT:
+        return sizeof(float);
+    case DATA_SET_DATA_TYPE_DOUBLE:
+        return sizeof(double);
+    case DATA_SET_DATA_TYPE_BOOLEAN:
+        return sizeof(uint8_t);
+    default:
+        return 0;
+    }
+}
+
+static inline bool isString(uint32_t type)
+{
+    return type == DATA_SET_DATA_TYPE_STRING || type == DATA_SET_DATA_TYPE_TEXT;
+}
+
+static inline void setBit(vector<uint64_t> &bits, size_t index)
+{
+    bits[index >> 6] |= (uint64_t)1 << (index & 63);
+}
+
+static inline bool getBit(const vector<uint64_t> &bits, size_t index)
+{
+    return (index >> 6) < bits.size() && ((bits[index >> 6] >> (index & 63)) & 1);
+}
+
+bool DataSet::process(tahu::DataSet *source)
+{
+    size_t columnCount = source->columns_count;
+    bool reshaped = columnCount != columns.size();
+
+    for (size_t i = 0; i < columnCount && !reshaped; i++)
+    {
+        const char *name = source->columns[i] ? source->columns[i] : "";
+        uint32_t type = i < source->types_count ? source->types[i] : DATA_SET_DATA_TYPE_UNKNOWN;
+        reshaped = columns[i].type != type || columns[i].name.compare(name) != 0;
+    }
+
+    if (reshaped)
+    {
+        // A DataSet with different columns is compared as if every row is new
+        columns.clear();
+        columns.resize(columnCount);
+        rows = 0;
+
+        for (size_t i = 0; i < columnCount; i++)
+        {
+            columns[i].name = source->columns[i] ? source->columns[i] : "";
+            columns[i].type = i < source->types_count ? source->types[i] : DATA_SET_DATA_TYPE_UNKNOWN;
+            columns[i].width = widthOf(columns[i].type);
+            columns[i].changed = true;
+        }
+    }
+
+    size_t nextRows = source->rows_count;
+    bool changed = reshaped || nextRows != rows;
+
+    changedRows.resize((nextRows + 63) / 64, 0);
+    if (nextRows & 63)
+    {
+        // Drops flags of removed rows sharing the last word
+        changedRows.back() &= ((uint64_t)1 << (nextRows & 63)) - 1;
+    }
+
+    for (size_t i = 0; i < columnCount; i++)
+    {
+        Column next;
+        next.name = std::move(columns[i].name);
+        next.type = columns[i].type;
+        next.width = columns[i].width;
+
+        readColumn(source, i, next);
+        changed = compare(columns[i], next, nextRows) || changed;
+
+        columns[i] = std::move(next);
+    }
+
+    rows = nextRows;
+
+    return changed;
+}
+
+void DataSet::readColumn(tahu::DataSet *source, size_t index, Column &target)
+{
+    size_t count = source->rows_count;
+
+    target.values.assign(count * target.width, 0);
+    target.nulls.assign((count + 63) / 64, 0);
+
+    bool strings = isString(target.type);
+    if (strings)
+    {
+        target.offsets.reserve(count + 1);
+        target.offsets.push_back(0);
+    }
+
+    for (size_t row = 0; row < count; row++)
+    {
+        tahu::DataSetRow &sourceRow = source->rows[row];
+
+        if (index >= sourceRow.elements_count || sourceRow.elements[index].which_value == 0)
+        {
+            setBit(target.nulls, row);
+            if (strings)
+            {
+                target.offsets.push_back(target.characters.size());
+            }
+            continue;
+        }
+
+        tahu::DataSetValue &cell = sourceRow.elements[index];
+        uint8_t *value = target.values.data() + row * target.width;
+
+        switch (target.type)
+        {
+        case DATA_SET_DATA_TYPE_INT8:
+        case DATA_SET_DATA_TYPE_INT16:
+        case DATA_SET_DATA_TYPE_INT32:
+        case DATA_SET_DATA_TYPE_UINT8:
+        case DATA_SET_DATA_TYPE_UINT16:
+        case DATA_SET_DATA_TYPE_UINT32:
+            memcpy(value, &cell.value.int_value, sizeof(uint32_t));
+            break;
+        case DATA_SET_DATA_TYPE_INT64:
+        case DATA_SET_DATA_TYPE_UINT64:
+        case DATA_SET_DATA_TYPE_DATETIME:
+            memcpy(value, &cell.value.long_value, sizeof(uint64_t));
+            break;
+        case DATA_SET_DATA_TYPE_FLOAT:
+            memcpy(value, &cell.value.float_value, sizeof(float));
+            break;
+        case DATA_SET_DATA_TYPE_DOUBLE:
+            memcpy(value, &cell.value.double_value, sizeof(double));
+            break;
+        case DATA_SET_DATA_TYPE_BOOLEAN:
+            *value = cell.value.boolean_value;
+            break;
+        case DATA_SET_DATA_TYPE_STRING:
+        case DATA_SET_DATA_TYPE_TEXT:
+            if (cell.value.string_value)
+            {
+                const char *text = cell.value.string_value;
+                target.characters.insert(target.characters.end(), text, text + strlen(text));
+            }
+            else
+            {
+                setBit(target.nulls, row);
+            }
+            target.offsets.push_back(target.characters.size());
+            break;
+        default:
+            setBit(target.nulls, row);
+            break;
+        }
+    }
+}
+
+bool DataSet::compare(Column &current, Column &next, size_t nextRows)
+{
+    size_t common = min(rows, nextRows);
+    bool changed = nextRows < rows;
+
+    bool identical = false;
+    if (next.width > 0 && common > 0)
+    {
+        // Whole column comparison before falling back to comparing rows
+        size_t words = common / 64;
+        identical = memcmp(current.values.data(), next.values.data(), common * next.width) == 0 &&
+                    equal(current.nulls.begin(), current.nulls.begin() + words, next.nulls.begin());
+        for (size_t row = words * 64; identical && row < common; row++)
+        {
+            identical = getBit(current.nulls, row) == getBit(next.nulls, row);
+        }
+    }
+
+    for (size_t row = 0; row < common && !identical; row++)
+    {
+        bool null = getBit(next.nulls, row);
+        bool differs = getBit(current.nulls, row) != null;
+
+        if (!differs && !null)
+        {
+            if (next.width > 0)
+            {
+                differs = memcmp(current.values.data() + row * next.width, next.values.data() + row * next.width, next.width) != 0;
+            }
+            else if (isString(next.type))
+            {
+                size_t currentLength = current.offsets[row + 1] - current.offsets[row];
+                size_t nextLength = next.offsets[row + 1] - next.offsets[row];
+                differs = currentLength != nextLength ||
+                          memcmp(current.characters.data() + current.offsets[row], next.characters.data() + next.offsets[row], nextLength) != 0;
+            }
+        }
+
+        if (differs)
+        {
+            setBit(changedRows, row);
+            changed = true;
+        }
+    }
+
+    for (size_t row = common; row < nextRows; row++)
+    {
+        setBit(changedRows, row);
+        changed = true;
+    }
+
+    next.changed = current.changed || changed;
+    return changed;
+}
+
+void DataSet::appendTo(tahu::DataSet *target)
+{
+    target->has_num_of_columns = true;
+    target->num_of_columns = columns.size();
+
+    if (!columns.empty())
+    {
+        target->columns_count = columns.size();
+        target->columns = (char **)calloc(columns.size(), sizeof(char *));
+        target->types_count = columns.size();
+        target->types = (uint32_t *)calloc(columns.size(), sizeof(uint32_t));
+
+        for (size_t i = 0; i < columns.size(); i++)
+        {
+            target->columns[i] = strdup(columns[i].name.c_str());
+            target->types[i] = columns[i].type;
+        }
+    }
+
+    if (rows == 0 || columns.empty())
+    {
+        return;
+    }
+
+    target->rows_count = rows;
+    target->rows = (tahu::DataSetRow *)calloc(rows, sizeof(tahu::DataSetRow));
+
+    for (size_t row = 0; row < rows; row++)
+    {
+        tahu::DataSetRow &targetRow = target->rows[row];
+        targetRow.elements_count = columns.size();
+        targetRow.elements = (tahu::DataSetValue *)calloc(columns.size(), sizeof(tahu::DataSetValue));
+
+        for (size_t i = 0; i < columns.size(); i++)
+        {
+            Column &column = columns[i];
+            tahu::DataSetValue &cell = targetRow.elements[i];
+            const uint8_t *value = column.values.data() + row * column.width;
+
+            if (getBit(column.nulls, row))
+            {
+                continue;
+            }
+
+            switch (column.type)
+            {
+            case DATA_SET_DATA_TYPE_INT8:
+            case DATA_SET_DATA_TYPE_INT16:
+            case DATA_SET_DATA_TYPE_INT32:
+            case DATA_SET_DATA_TYPE_UINT8:
+            case DATA_SET_DATA_TYPE_UINT16:
+            case DATA_SET_DATA_TYPE_UINT32:
+                cell.which_value = org_eclipse_tahu_protobuf_Payload_DataSet_DataSetValue_int_value_tag;
+                memcpy(&cell.value.int_value, value, sizeof(uint32_t));
+                break;
+            case DATA_SET_DATA_TYPE_INT64:
+            case DATA_SET_DATA_TYPE_UINT64:
+            case DATA_SET_DATA_TYPE_DATETIME:
+                cell.which_value = org_eclipse_tahu_protobuf_Payload_DataSet_DataSetValue_long_value_tag;
+                memcpy(&cell.value.long_value, value, sizeof(uint64_t));
+                break;
+            case DATA_SET_DATA_TYPE_FLOAT:
+                cell.which_value = org_eclipse_tahu_protobuf_Payload_DataSet_DataSetValue_float_value_tag;
+                memcpy(&cell.value.float_value, value, sizeof(float));
+                break;
+            case DATA_SET_DATA_TYPE_DOUBLE:
+                cell.which_value = org_eclipse_tahu_protobuf_Payload_DataSet_DataSetValue_double_value_tag;
+                memcpy(&cell.value.double_value, value, sizeof(double));
+                break;
+            case DATA_SET_DATA_TYPE_BOOLEAN:
+                cell.which_value = org_eclipse_tahu_protobuf_Payload_DataSet_DataSetValue_boolean_value_tag;
+                cell.value.boolean_value = *value != 0;
+                break;
+            case DATA_SET_DATA_TYPE_STRING:
+            case DATA_SET_DATA_TYPE_TEXT:
+                cell.which_value = org_eclipse_tahu_protobuf_Payload_DataSet_DataSetValue_string_value_tag;
+                cell.value.string_value = strndup(column.characters.data() + column.offsets[row], column.offsets[row + 1] - column.offsets[row]);
+                break;
+            default:
+                break;
+            }
+        }
+    }
+}
+
+void DataSet::acknowledge()
+{
+    fill(changedRows.begin(), changedRows.end(), 0);
+    for (auto &column : columns)
+    {
+        column.changed = false;
+    }
+}
+
+bool DataSet::isDirty()
+{
+    return any_of(columns.begin(), columns.end(), [](Column &column)
+                  { return column.changed; });
+}
+
+bool DataSet::isRowChanged(size_t row) const
+{
+    return getBit(changedRows, row);
+}
+
+bool DataSet::isColumnChanged(size_t column) const
+{
+    return columns[column].changed;
+}
+
+size_t DataSet::getRowCount() const
+{
+    return rows;
+}
+
+size_t DataSet::getColumnCount() const
+{
+    return columns.size();
+}
+
+const string &DataSet::getColumnName(size_t column) const
+{
+    return columns[column].name;
+}
+
+uint32_t DataSet::getColumnType(size_t column) const
+{
+    return columns[column].type;
+}
+
+bool DataSet::isNull(size_t column, size_t row) const
+{
+    return getBit(columns[column].nulls, row);
+}
+
+string_view DataSet::getString(size_t column, size_t row) const
+{
+    const Column &target = columns[column];
+    if (!isString(target.type) || getBit(target.nulls, row))
+    {
+        return string_view();
+    }
+    return string_view(target.characters.data() + target.offsets[row], target.offsets[row + 1] - target.offsets[row]);
+}
@@ -0,0 +1,159 @@
+/*
+ * File: DataSet.h
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#ifndef SRC_TYPES_DATASET
+#define SRC_TYPES_DATASET
+
+#include "TahuTypes.h"
+#include "CommonTypes.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief A Sparkplug DataSet stored by column.
+ * Each column holds its values in a single typed buffer along with a null bitmap, allowing
+ * columns to be read without copying. Repeated DataSets are compared with the previous values,
+ * flagging only the rows and columns that changed.
+ *
+ */
+class DataSet
+{
+private:
+    struct Column
+    {
+        std::string name;
+        uint32_t type = DATA_SET_DATA_TYPE_UNKNOWN;
+        /**
+         * @brief Bytes per value for fixed width columns, 0 for string columns
+         *
+         */
+        size_t width = 0;
+        std::vector<uint8_t> values;
+        /**
+         * @brief String columns hold their characters in one buffer, row N spans offsets[N] to offsets[N + 1]
+         *
+         */
+        std::vector<uint32_t> offsets;
+        std::vector<char> characters;
+        std::vector<uint64_t> nulls;
+        bool changed = false;
+    };
+
+    std::vector<Column> columns;
+    size_t rows = 0;
+    std::vector<uint64_t> changedRows;
+
+    /**
+     * @brief Reads a column from a DataSet into a new Column with the same name and type
+     *
+     * @param source
+     * @param index The index of the column
+     * @param target
+     */
+    void readColumn(tahu::DataSet *source, size_t index, Column &target);
+    /**
+     * @brief Compares a newly read column to the current column, flagging the rows that changed
+     *
+     * @param current
+     * @param next
+     * @param nextRows
+     * @return true Rows of the column changed
+     * @return false
+     */
+    bool compare(Column &current, Column &next, size_t nextRows);
+
+protected:
+public:
+    /**
+     * @brief Processes a DataSet value, flagging the rows and columns that changed.
+     * Flagged changes accumulate until they are acknowledged.
+     *
+     * @param source
+     * @return true The DataSet differs from the previously processed value
+     * @return false The DataSet was republished unchanged
+     */
+    bool process(tahu::DataSet *source);
+    /**
+     * @brief Writes the complete DataSet to a tahu::DataSet
+     *
+     * @param target
+     */
+    void appendTo(tahu::DataSet *target);
+    /**
+     * @brief Clears the flagged row and column changes
+     *
+     */
+    void acknowledge();
+    /**
+     * @brief Whether any rows or columns changed since the changes were last acknowledged
+     *
+     * @return true
+     * @return false
+     */
+    bool isDirty();
+    bool isRowChanged(size_t row) const;
+    bool isColumnChanged(size_t column) const;
+    size_t getRowCount() const;
+    size_t getColumnCount() const;
+    const std::string &getColumnName(size_t column) const;
+    uint32_t getColumnType(size_t column) const;
+    bool isNull(size_t column, size_t row) const;
+    /**
+     * @brief Gets the values of a fixed width column without copying.
+     * Integers up to 32 bits are stored as uint32_t, 64 bit integers and DateTimes as uint64_t
+     * and Booleans as uint8_t. Null values are zeroed.
+     *
+     * @tparam T The stored type of the column
+     * @param column
+     * @return const T* The values, or nullptr if the column isn't stored as T
+     */
+    template <typename T>
+    const T *getColumn(size_t column) const
+    {
+        const Column &target = columns[column];
+        if (target.width != sizeof(T))
+        {
+            return nullptr;
+        }
+        return reinterpret_cast<const T *>(target.values.data());
+    }
+    /**
+     * @brief Gets a value of a String or Text column without copying
+     *
+     * @param column
+     * @param row
+     * @return std::string_view
+     */
+    std::string_view getString(size_t column, size_t row) const;
+};
+
+#endif /* SRC_TYPES_DATASET */
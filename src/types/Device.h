@@ -43,6 +43,7 @@ protected:
 public:
     Device(){};
     Device(std::string name) : Publishable(name){};
+    Device(std::string name, ModelContext *context) : Publishable(name, context){};
     /**
      * @brief Returns true as it is a Device
      *
@@ -30,6 +30,8 @@
  */
 
 #include "Group.h"
+#include <cstring>
+#include <algorithm>
 #include <functional> //for std::hash
 
 #define DEBUGGING 1
@@ -41,15 +43,142 @@
 #define LOGGER(out, ...)
 #endif
 
-ParseResult Group::process(SparkplugTopic &topic, tahu::Payload *payload)
+Group::Group(std::string name, ModelContext *context) : name(name)
+{
+    statistics->parent = &context->statistics;
+    factory = [this, context](std::string &name)
+    {
+        Node *node = nodes.create(name, context);
+        node->useStatistics(statistics.get());
+        return node;
+    };
+    destroy = [this](Node *node)
+    {
+        node->useStatistics(nullptr);
+        nodes.destroy(node);
+    };
+}
+
+Group::~Group()
+{
+    // Nodes are allocated from the Group's pool, so they must be released before the pool is
+    clear();
+}
+
+ParseResult Group::process(SparkplugTopic &topic, tahu::Payload *payload, PayloadReader *reader)
+{
+    Node *node = resolve(topic);
+    ParseResult result = node->process(topic, payload, reader);
+    version = std::max(version, node->getVersion());
+    return result;
+}
+
+Node *Group::resolve(SparkplugTopic &topic)
 {
     auto nodeSource = std::string(topic.getGroup() + "/" + topic.getNode());
-    auto node = get(nodeSource);
-    return node->process(topic, payload);
+    return get(nodeSource);
+}
+
+void Group::appendTo(std::vector<PublishableUpdate> &payloads, bool force, uint64_t subscribers)
+{
+    each([&payloads, force, subscribers](Node *node)
+         { node->appendTo(payloads, force, subscribers); });
+}
+
+void Group::subscribe()
+{
+    each([](Node *node)
+         { node->subscribe(); });
+}
+
+void Group::restore(const std::string &node, const std::string &device, tahu::Payload *payload)
+{
+    auto nodeSource = std::string(name + "/" + node);
+    Node *target = get(nodeSource);
+    target->restore(device, payload);
+    version = std::max(version, target->getVersion());
+}
+
+void Group::appendSince(std::vector<PublishableUpdate> &payloads, uint64_t since, uint64_t subscribers)
+{
+    if (version <= since)
+    {
+        return;
+    }
+
+    each([&payloads, since, subscribers](Node *node)
+         { node->appendSince(payloads, since, subscribers); });
+}
+
+void Group::expire(Publishable *publisher)
+{
+    publisher->expire();
+    track(publisher);
+}
+
+void Group::track(Publishable *publisher)
+{
+    // Devices are named group/node/device, their Node is the first two segments
+    const std::string &source = publisher->getName();
+    Node *node = find(source.substr(0, source.find('/', name.size() + 1)));
+    if (node)
+    {
+        node->track(publisher->getVersion());
+        version = std::max(version, node->getVersion());
+    }
+}
+
+std::shared_ptr<const ModelStatistics> Group::getStatistics()
+{
+    return statistics;
+}
+
+void Group::sample(double seconds)
+{
+    statistics->sample(seconds);
+}
+
+void Group::appendLatency(std::vector<PublishableUpdate> &payloads, bool force, uint64_t timestamp)
+{
+    each([&payloads, force, timestamp](Node *node)
+         {
+            LatencyTracker &latency = node->getLatency();
+            if (!latency.hasChanges() && !(force && latency.getProcessing().getCount() > 0))
+            {
+                return;
+            }
+
+            tahu::Payload *payload = (tahu::Payload *)malloc(sizeof(tahu::Payload));
+            memset(payload, 0, sizeof(tahu::Payload));
+            payload->has_timestamp = true;
+            payload->timestamp = timestamp;
+
+            latency.appendTo(payload, timestamp);
+            payloads.push_back(PublishableUpdate(payload, node->getName(), UpdateType::PUBLISH)); });
+}
+
+void Group::appendLimited(std::map<std::string, uint64_t> &nodes)
+{
+    each([&nodes](Node *node)
+         {
+            if (node->getLimited() > 0)
+            {
+                nodes[node->getName()] = node->getLimited();
+            } });
+}
+
+uint64_t Group::getVersion()
+{
+    return version;
+}
+
+void Group::snapshot(SnapshotWriter &writer)
+{
+    each([&writer](Node *node)
+         { node->snapshot(writer); });
 }
 
-void Group::appendTo(std::vector<PublishableUpdate> &payloads, bool force)
+std::string &Group::getName()
 {
-    each([&payloads, force](Node *node)
-         { node->appendTo(payloads, force); });
+    return name;
 }
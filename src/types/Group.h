@@ -34,6 +34,7 @@
 
 #include <map>
 #include <string>
+#include <memory>
 #include "Node.h"
 #include "PublishableUpdate.h"
 #include "../DataCollection.h"
@@ -46,27 +47,125 @@ class Group : public DataCollection<Node>
 {
 private:
     std::string name;
+    ObjectPool<Node> nodes;
+    /**
+     * @brief The latest model version of any Node on the Group
+     *
+     */
+    uint64_t version = 0;
+    /**
+     * @brief Shared so the statistics can still be read after the Group is released
+     *
+     */
+    std::shared_ptr<ModelStatistics> statistics = std::make_shared<ModelStatistics>();
 
 protected:
 public:
     Group(){};
     Group(std::string name) : name(name){};
-    ~Group(){};
+    Group(std::string name, ModelContext *context);
+    ~Group();
     /**
      * @brief Processes a Payload for a Node/Device on a group
      *
      * @param topic
      * @param payload
+     * @param reader A reader over the encoded payload when only its header has been decoded
      * @return ParseResult
      */
-    ParseResult process(SparkplugTopic &topic, tahu::Payload *payload);
+    ParseResult process(SparkplugTopic &topic, tahu::Payload *payload, PayloadReader *reader = nullptr);
+    /**
+     * @brief Resolves the Node a topic is targeting, creating it if it doesn't exist
+     *
+     * @param topic
+     * @return Node*
+     */
+    Node *resolve(SparkplugTopic &topic);
     /**
      * @brief Appends any payloads from Nodes/Devices on this Group
      *
      * @param payloads
      * @param force Forces all payloads to be appended
+     * @param subscribers Only appends Metrics that match one of these subscribers
+     */
+    void appendTo(std::vector<PublishableUpdate> &payloads, bool force = false, uint64_t subscribers = ALL_SUBSCRIBERS);
+    /**
+     * @brief Appends Payloads of the Nodes and Devices changed after a model version, without acknowledging any changes
+     *
+     * @param payloads
+     * @param since The model version
+     * @param subscribers Only appends Metrics that match one of these subscribers
+     */
+    void appendSince(std::vector<PublishableUpdate> &payloads, uint64_t since, uint64_t subscribers = ALL_SUBSCRIBERS);
+    /**
+     * @brief Gets the latest model version of any Node on the Group
+     *
+     * @return uint64_t
+     */
+    uint64_t getVersion();
+    /**
+     * @brief Stales a Node or Device of the Group whose inactivity timer expired
+     *
+     * @param publisher
+     */
+    void expire(Publishable *publisher);
+    /**
+     * @brief Tracks the version of a Node or Device of the Group that changed outside of a message
+     *
+     * @param publisher
+     */
+    void track(Publishable *publisher);
+    /**
+     * @brief Gets the statistics of the Nodes and Devices on the Group
+     *
+     * @return std::shared_ptr<const ModelStatistics>
+     */
+    std::shared_ptr<const ModelStatistics> getStatistics();
+    /**
+     * @brief Updates the message rate of the Group
+     *
+     * @param seconds The time since the last sample
+     */
+    void sample(double seconds);
+    /**
+     * @brief Appends a payload of latency Metrics for each Node that received messages since they were last appended
+     *
+     * @param payloads
+     * @param force Appends a payload for every Node that has received messages
+     * @param timestamp The timestamp of the payloads in milliseconds since the epoch
+     */
+    void appendLatency(std::vector<PublishableUpdate> &payloads, bool force, uint64_t timestamp);
+    /**
+     * @brief Adds the Nodes that have sent data messages over their rate limit
+     *
+     * @param nodes The number of limited messages of each Node, by name
+     */
+    void appendLimited(std::map<std::string, uint64_t> &nodes);
+    /**
+     * @brief Matches every Metric on this Group against the Metric filters and deadbands
+     *
+     */
+    void subscribe();
+    /**
+     * @brief Restores a Node or Device of this Group from a snapshot
+     *
+     * @param node The name of the Node
+     * @param device The name of the Device, or empty for the Node
+     * @param payload
+     */
+    void restore(const std::string &node, const std::string &device, tahu::Payload *payload);
+    /**
+     * @brief Adds the live Nodes and Devices of this Group to a snapshot
+     *
+     * @param writer
+     */
+    void snapshot(SnapshotWriter &writer);
+    /**
+     * @brief Get the name of the Group
+     *
+     * @return std::string&
      */
-    void appendTo(std::vector<PublishableUpdate> &payloads, bool force = false);
+    std::string &getName();
 };
 
 #endif /* SRC_TYPES_GROUP */
@@ -30,6 +30,7 @@
  */
 
 #include "Metric.h"
+#include "MetricHandles.h"
 
 using namespace std;
 
@@ -42,18 +43,40 @@ using namespace std;
 #define LOGGER(out, ...)
 #endif
 
-void Metric::appendTo(tahu::Payload *payload, bool force)
+void Metric::appendTo(tahu::Payload *payload, bool force, uint64_t subscribers)
 {
-    if (!flags.dirty && !force)
+    if ((!flags.dirty && !force) || !isSubscribed(subscribers))
     {
         return;
     }
 
+    append(payload, force, false);
+
     if (!force)
     {
         flags.dirty = false;
+        flags.qualityDirty = false;
+        value.acknowledge();
+    }
+}
+
+void Metric::snapshot(tahu::Payload *payload)
+{
+    append(payload, true, true);
+}
+
+void Metric::appendSince(tahu::Payload *payload, uint64_t since, uint64_t subscribers)
+{
+    if (version <= since || !isSubscribed(subscribers))
+    {
+        return;
     }
 
+    append(payload, true, false);
+}
+
+void Metric::append(tahu::Payload *payload, bool force, bool withAlias)
+{
     tahu::Metric *metric;
 
     metric = (tahu::Metric *)malloc(sizeof(tahu::Metric));
@@ -61,62 +84,77 @@ void Metric::appendTo(tahu::Payload *payload, bool force)
 
     propertySet.appendTo(metric, force);
 
-    metric->has_alias = false;
+    if (flags.hasQuality && (force || flags.qualityDirty))
+    {
+        add_property_to_set(&metric->properties, QUALITY_PROPERTY, PROPERTY_DATA_TYPE_INT32, &quality, sizeof(quality));
+        metric->has_properties = true;
+    }
+
+    metric->has_alias = withAlias && flags.hasAlias;
+    metric->alias = metric->has_alias ? alias : 0;
     metric->has_is_historical = metric->is_historical = flags.isHistorical;
     metric->has_is_transient = metric->is_transient = flags.isTransient;
-    metric->has_is_null = metric->is_null = flags.isNull;
     metric->has_timestamp = flags.hasTimestamp;
-    metric->datatype = this->type;
-    metric->has_datatype = true;
-    metric->which_value = this->whichValue;
 
     metric->timestamp = timestamp;
 
     metric->name = strdup(name.c_str());
 
-    if (type == METRIC_DATA_TYPE_STRING || type == METRIC_DATA_TYPE_TEXT)
-    {
-        metric->value.string_value = strdup(value.stringValue);
-    }
-    else
-    {
-        memcpy(&metric->value, &value, sizeof(value));
-    }
+    value.appendTo(metric, force);
 
     add_metric_to_payload(payload, metric);
 
     free(metric);
 }
 
-inline void Metric::clearValue()
+ParseResult Metric::process(tahu::Metric *metric, MetricHeader &header, MetricScope *scope)
 {
-    switch (type)
+    ParseResult result = process(metric, scope);
+    if (result == ParseResult::OK)
     {
-    case METRIC_DATA_TYPE_STRING:
-    case METRIC_DATA_TYPE_TEXT:
-        if (value.stringValue)
-        {
-            free(value.stringValue);
-        }
-        break;
-    default:
-        break;
+        digest = header.digest;
     }
-    memset(&value, 0, sizeof(MetricValueUnion));
+    return result;
 }
 
-ParseResult Metric::process(tahu::Metric *metric)
+void Metric::evict(uint64_t version)
 {
     flags.dirty = true;
+    // Republished bytes have to be stored again, even if they're identical to the evicted bytes
+    digest = 0;
+    this->version = version;
+}
 
-    if (metric->datatype != type && type != PROPERTY_DATA_TYPE_UNKNOWN)
+bool Metric::unchanged(MetricHeader &header)
+{
+    if (digest == 0 || digest != header.digest)
+    {
+        return false;
+    }
+
+    flags.hasTimestamp = header.hasTimestamp;
+    timestamp = header.hasTimestamp ? header.timestamp : 0;
+    return true;
+}
+
+ParseResult Metric::process(tahu::Metric *metric, MetricScope *scope)
+{
+    bool dirty = flags.dirty;
+    flags.dirty = true;
+    digest = 0;
+
+    if (metric->has_datatype && metric->datatype != value.getType() && value.getType() != METRIC_DATA_TYPE_UNKNOWN)
     {
         return ParseResult::OUT_OF_SYNC;
     }
 
+    const PropertyTable *properties = propertySet.getTable();
+    int32_t previousQuality = quality;
+    bool hadQuality = flags.hasQuality;
+
     if (metric->has_properties)
     {
-        propertySet.process(&metric->properties);
+        propertySet.process(&metric->properties, processQuality(&metric->properties));
     }
 
     flags.isHistorical = metric->has_is_historical && metric->is_historical;
@@ -133,81 +171,69 @@ ParseResult Metric::process(tahu::Metric *metric)
         timestamp = 0;
     }
 
-    if ((metric->has_is_null && !metric->is_null) || !metric->has_is_null)
+    if (scope)
     {
-        flags.isNull = false;
+        scope->metric = this;
+    }
 
-        switch (metric->datatype)
-        {
-        case METRIC_DATA_TYPE_INT8:
-        case METRIC_DATA_TYPE_UINT8:
-            length = sizeof(int8_t);
-            value.intValue = metric->value.int_value;
-            break;
-        case METRIC_DATA_TYPE_INT16:
-        case METRIC_DATA_TYPE_UINT16:
-            length = sizeof(int16_t);
-            value.intValue = metric->value.int_value;
-            break;
-        case METRIC_DATA_TYPE_INT32:
-        case METRIC_DATA_TYPE_UINT32:
-            length = sizeof(int32_t);
-            value.intValue = metric->value.int_value;
-            break;
-        case METRIC_DATA_TYPE_INT64:
-        case METRIC_DATA_TYPE_UINT64:
-        case METRIC_DATA_TYPE_DATETIME:
-            length = sizeof(int64_t);
-            value.longValue = metric->value.long_value;
-            break;
-        case METRIC_DATA_TYPE_FLOAT:
-            length = sizeof(float);
-            value.floatValue = metric->value.float_value;
-            break;
-        case METRIC_DATA_TYPE_DOUBLE:
-            length = sizeof(double);
-            value.doubleValue = metric->value.double_value;
-            break;
-        case METRIC_DATA_TYPE_BOOLEAN:
-            length = sizeof(bool);
-            value.booleanValue = metric->value.boolean_value;
-            break;
-        case METRIC_DATA_TYPE_STRING:
-        case METRIC_DATA_TYPE_TEXT:
-            if (value.stringValue)
-            {
-                free(value.stringValue);
-            }
-            if (metric->value.string_value)
-            {
-                length = strlen(metric->value.string_value) + 1;
-                value.stringValue = strdup(metric->value.string_value);
-            }
-            else
-            {
-                length = 0;
-                value.stringValue = nullptr;
-            }
-            break;
-        case METRIC_DATA_TYPE_BYTES:
-        case METRIC_DATA_TYPE_DATASET:
-        case METRIC_DATA_TYPE_UUID:
-        case METRIC_DATA_TYPE_UNKNOWN:
-        default:
-            flags.isNull = true;
-            clearValue();
-            break;
-        }
+    ParseResult result = value.process(metric, scope);
+
+    if (scope)
+    {
+        scope->metric = nullptr;
     }
-    else
+
+    bool hasReference = flags.hasReference;
+    bool changed = value.update(deadband, reference, hasReference);
+    flags.hasReference = hasReference;
+
+    // Changed properties replace the shared property table
+    changed = changed || propertySet.getTable() != properties || quality != previousQuality || hadQuality != flags.hasQuality;
+
+    // Republished values within the deadband, and DataSets and arrays without changed rows, columns or elements,
+    // only flag the Metric when their properties changed
+    if (!changed)
+    {
+        flags.dirty = dirty;
+    }
+    else if (scope && scope->version)
     {
-        clearValue();
+        version = ++*scope->version;
     }
 
-    whichValue = metric->which_value;
-    type = metric->datatype;
+    return result;
+}
 
-    return ParseResult::OK;
+int Metric::processQuality(tahu::PropertySet *propertySet)
+{
+    for (size_t i = 0; i < propertySet->keys_count && i < propertySet->values_count; i++)
+    {
+        const char *key = propertySet->keys[i];
+        tahu::Property *property = &propertySet->values[i];
+
+        if (key[0] != 'Q' || strcmp(key, QUALITY_PROPERTY) != 0)
+        {
+            continue;
+        }
+
+        // Quality is an Int32, other datatypes are kept as ordinary properties
+        if (property->type < PROPERTY_DATA_TYPE_INT8 || property->type > PROPERTY_DATA_TYPE_UINT32 ||
+            property->type == PROPERTY_DATA_TYPE_INT64 || (property->has_is_null && property->is_null))
+        {
+            return -1;
+        }
+
+        int32_t reported = property->value.int_value;
+        if (!flags.hasQuality || reported != quality)
+        {
+            quality = reported;
+            flags.hasQuality = true;
+            flags.qualityDirty = true;
+        }
+        return i;
+    }
+
+    return -1;
 }
 
 bool Metric::isDirty()
@@ -215,18 +241,115 @@ bool Metric::isDirty()
     return flags.dirty;
 }
 
+bool Metric::subscribe(uint64_t subscribers)
+{
+    bool subscribed = this->subscribers == 0 && subscribers != 0;
+    this->subscribers = subscribers;
+    return subscribed;
+}
+
+void Metric::invalidate()
+{
+    value.clear();
+    flags.hasReference = false;
+    timestamp = 0;
+    digest = 0;
+}
+
+bool Metric::isSubscribed(uint64_t subscribers)
+{
+    return (this->subscribers & subscribers) != 0;
+}
+
+void Metric::setDeadband(Deadband deadband)
+{
+    this->deadband = deadband;
+}
+
+bool Metric::hasQuality()
+{
+    return flags.hasQuality;
+}
+
+int32_t Metric::getQuality()
+{
+    return quality;
+}
+
+void Metric::watchQuality(bool enabled)
+{
+    flags.watchQuality = enabled;
+}
+
+bool Metric::isQualityWatched()
+{
+    return flags.watchQuality;
+}
+
+void Metric::setAlias(uint64_t alias)
+{
+    flags.hasAlias = true;
+    this->alias = alias;
+}
+
+std::string &Metric::getName()
+{
+    return name;
+}
+
+uint64_t Metric::getTimestamp()
+{
+    return timestamp;
+}
+
+uint64_t Metric::getVersion()
+{
+    return version;
+}
+
+uint32_t Metric::getType()
+{
+    return value.getType();
+}
+
+void Metric::read(MetricReading &reading)
+{
+    reading.valid = true;
+    reading.datatype = value.getType();
+    reading.hasValue = value.readScalar(reading.value);
+    reading.quality = quality;
+    reading.timestamp = timestamp;
+}
+
+uint32_t Metric::getHandle()
+{
+    return handle;
+}
+
+void Metric::setHandle(uint32_t handle)
+{
+    this->handle = handle;
+}
+
+MetricValue &Metric::getValue()
+{
+    return value;
+}
+
 void Metric::clear()
 {
-    clearValue();
+    value.reset();
+    propertySet.clear();
+    quality = QUALITY_GOOD;
 
     flags.data = 0;
     timestamp = 0;
-    type = METRIC_DATA_TYPE_UNKNOWN;
+    digest = 0;
 }
 
 Metric::Metric(string &name)
 {
-    clearValue();
+    flags.data = 0;
     this->name = string(name);
 }
 
@@ -234,3 +357,35 @@ Metric::~Metric()
 {
     clear();
 }
+
+bool Metric::rebirth(uint32_t datatype)
+{
+    uint32_t type = value.getType();
+    bool retyped = type != METRIC_DATA_TYPE_UNKNOWN && datatype != type;
+
+    if (retyped || type == METRIC_DATA_TYPE_TEMPLATE)
+    {
+        value.reset();
+    }
+
+    // Births replace the properties, while subscriptions are matched again once the birth is loaded
+    propertySet.clear();
+    quality = QUALITY_GOOD;
+    timestamp = 0;
+    digest = 0;
+    alias = 0;
+
+    bool watched = flags.watchQuality;
+    flags.data = 0;
+    flags.watchQuality = watched;
+    flags.reborn = true;
+
+    return retyped;
+}
+
+bool Metric::wasReborn()
+{
+    bool reborn = flags.reborn;
+    flags.reborn = false;
+    return reborn;
+}
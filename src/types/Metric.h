@@ -34,22 +34,37 @@
 
 #include "TahuTypes.h"
 #include "PropertySet.h"
+#include "MetricValue.h"
+#include "Template.h"
 #include "CommonTypes.h"
+#include "../utilities/PayloadReader.h"
+#include "../utilities/MetricFilters.h"
 #include <string>
 
+#define QUALITY_PROPERTY "Quality"
+#define QUALITY_BAD 0
+#define QUALITY_GOOD 192
+#define QUALITY_STALE 500
+
+struct MetricReading;
+
 union MetricFlags
 {
-    uint8_t data;
+    uint16_t data;
     struct
     {
-        uint8_t hasTimestamp : 1;
-        uint8_t isHistorical : 1;
-        uint8_t isTransient : 1;
-        uint8_t isNull : 1;
-        uint8_t hasMetadata : 1;
-        uint8_t hasProperties : 1;
-        uint8_t dirty : 1;
-        uint8_t reserved : 1;
+        uint16_t hasTimestamp : 1;
+        uint16_t isHistorical : 1;
+        uint16_t isTransient : 1;
+        uint16_t hasReference : 1;
+        uint16_t hasMetadata : 1;
+        uint16_t hasProperties : 1;
+        uint16_t dirty : 1;
+        uint16_t hasAlias : 1;
+        uint16_t hasQuality : 1;
+        uint16_t qualityDirty : 1;
+        uint16_t watchQuality : 1;
+        uint16_t reborn : 1;
     };
 };
 
@@ -62,28 +77,51 @@ class Metric
 private:
     tahu::Metric *source;
     PropertySet propertySet;
-    size_t length = 0;
-    pb_size_t whichValue;
-    uint32_t type = METRIC_DATA_TYPE_UNKNOWN;
+    MetricValue value;
     std::string name;
     uint64_t timestamp;
+    uint64_t alias = 0;
+    uint64_t digest = 0;
+    uint64_t subscribers = ALL_SUBSCRIBERS;
+    /**
+     * @brief The model version of the last change to the Metric
+     *
+     */
+    uint64_t version = 0;
+    /**
+     * @brief The last value that changed the Metric, compared against using the deadband
+     *
+     */
+    uint64_t reference = 0;
+    Deadband deadband;
+    /**
+     * @brief The Quality property, kept apart from the Property Set as it changes far more often
+     *
+     */
+    int32_t quality = QUALITY_GOOD;
+    /**
+     * @brief The slot of the Metric in the handle table, or 0 if it has no handle
+     *
+     */
+    uint32_t handle = 0;
     MetricFlags flags;
 
-    union MetricValueUnion
-    {
-        uint32_t intValue;
-        uint64_t longValue;
-        float floatValue;
-        double doubleValue;
-        bool booleanValue;
-        char *stringValue;
-    } value;
+    /**
+     * @brief Reads the Quality property from a tahu::PropertySet
+     *
+     * @param propertySet
+     * @return int The index of the Quality property, or -1 if the set has none
+     */
+    int processQuality(tahu::PropertySet *propertySet);
 
     /**
-     * @brief Clears the value on the Metric
-     * Frees any allocated memory
+     * @brief Appends a copy of this Metric to a Payload
+     *
+     * @param payload
+     * @param force Forces all properties and Template members to be appended
+     * @param withAlias Whether the alias of the Metric is included
      */
-    inline void clearValue();
+    void append(tahu::Payload *payload, bool force, bool withAlias);
 
 protected:
     /**
@@ -95,20 +133,77 @@ protected:
 public:
     Metric(std::string &name);
     ~Metric();
+    /**
+     * @brief Prepares the Metric to be reloaded by a birth, keeping its allocations where possible.
+     * The value is only reset if the datatype changed or it's a Template, whose definition may have changed.
+     *
+     * @param datatype The datatype the Metric is birthed with
+     * @return true The datatype of the Metric changed
+     * @return false
+     */
+    bool rebirth(uint32_t datatype);
+    /**
+     * @brief Whether the Metric was included in the last birth, clearing the mark for the next birth
+     *
+     * @return true
+     * @return false
+     */
+    bool wasReborn();
     /**
      * @brief Appends this Metric to a Payload if it has had changes
      *
      * @param payload
      * @param force Forces the Metric to be appended
+     * @param subscribers Only appends the Metric if it matches one of these subscribers
+     */
+    void appendTo(tahu::Payload *payload, bool force = false, uint64_t subscribers = ALL_SUBSCRIBERS);
+    /**
+     * @brief Appends the complete Metric to a Payload, including its alias, without acknowledging it
+     *
+     * @param payload
      */
-    void appendTo(tahu::Payload *payload, bool force = false);
+    void snapshot(tahu::Payload *payload);
+    /**
+     * @brief Appends the complete Metric to a Payload if it changed after a model version, without acknowledging it
+     *
+     * @param payload
+     * @param since The model version
+     * @param subscribers Only appends the Metric if it matches one of these subscribers
+     */
+    void appendSince(tahu::Payload *payload, uint64_t since, uint64_t subscribers = ALL_SUBSCRIBERS);
     /**
      * @brief Processes a tahu::Metric and updates the Metric
      *
      * @param metric
+     * @param scope The Template definitions and Bytes budget available to the Metric's value
      * @return ParseResult
      */
-    ParseResult process(tahu::Metric *metric);
+    ParseResult process(tahu::Metric *metric, MetricScope *scope = nullptr);
+    /**
+     * @brief Processes a tahu::Metric read from an encoded Payload and updates the Metric
+     *
+     * @param metric
+     * @param header The header read along with the Metric
+     * @param scope The Template definitions and Bytes budget available to the Metric's value
+     * @return ParseResult
+     */
+    ParseResult process(tahu::Metric *metric, MetricHeader &header, MetricScope *scope = nullptr);
+    /**
+     * @brief Whether an encoded Metric is identical to the last one processed, compared by the digest of its encoding.
+     * If it is, only the timestamp of the Metric is updated. A change whose digest collides with the last value is
+     * skipped, see MetricHeader::digest.
+     *
+     * @param header The header of the encoded Metric
+     * @return true
+     * @return false
+     */
+    bool unchanged(MetricHeader &header);
+    /**
+     * @brief Marks the Metric changed after its Bytes value was evicted, so the value is reported as null
+     *
+     * @param version The model version of the eviction
+     */
+    void evict(uint64_t version);
     /**
      * @brief Whether the metric has data that hasn't been acknowledged
      *
@@ -116,6 +211,89 @@ public:
      * @return false
      */
     bool isDirty();
+    /**
+     * @brief Sets the subscribers whose filters match this Metric
+     *
+     * @param subscribers
+     * @return true The Metric had no subscribers and now has some
+     * @return false
+     */
+    bool subscribe(uint64_t subscribers);
+    /**
+     * @brief Marks the value unknown, clearing it while keeping its datatype.
+     * The next value received is applied and compared as if it were the first.
+     *
+     */
+    void invalidate();
+    /**
+     * @brief Whether the Metric matches any of the subscribers
+     *
+     * @param subscribers
+     * @return true
+     * @return false
+     */
+    bool isSubscribed(uint64_t subscribers = ALL_SUBSCRIBERS);
+    /**
+     * @brief Sets how new values are compared with the last changed value.
+     * Only values that change the Metric flag it as dirty.
+     *
+     * @param deadband
+     */
+    void setDeadband(Deadband deadband);
+    /**
+     * @brief Whether the Metric has reported a Quality property
+     *
+     * @return true
+     * @return false
+     */
+    bool hasQuality();
+    /**
+     * @brief Gets the Quality of the Metric, QUALITY_GOOD if it has never reported one
+     *
+     * @return int32_t
+     */
+    int32_t getQuality();
+    /**
+     * @brief Sets whether changes to the Quality of the Metric are reported
+     *
+     * @param enabled
+     */
+    void watchQuality(bool enabled);
+    bool isQualityWatched();
+    /**
+     * @brief Sets the alias the Metric was birthed with
+     *
+     * @param alias
+     */
+    void setAlias(uint64_t alias);
+    std::string &getName();
+    /**
+     * @brief Gets the timestamp of the last value, or 0 if it had none
+     *
+     * @return uint64_t
+     */
+    uint64_t getTimestamp();
+    /**
+     * @brief Gets the model version of the last change to the Metric
+     *
+     * @return uint64_t
+     */
+    uint64_t getVersion();
+    uint32_t getType();
+    /**
+     * @brief Reads the value, timestamp and Quality of the Metric without allocating
+     *
+     * @param reading
+     */
+    void read(MetricReading &reading);
+    uint32_t getHandle();
+    void setHandle(uint32_t handle);
+    /**
+     * @brief Gets the value of the Metric
+     *
+     * @return MetricValue&
+     */
+    MetricValue &getValue();
 };
 
 #endif /* SRC_TYPES_METRIC */
@@ -0,0 +1,89 @@
+/*
+ * File: MetricHandles.cpp
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#include "MetricHandles.h"
+#include "Publishable.h"
+
+MetricHandle MetricHandles::bind(Metric *metric, Publishable *owner)
+{
+    uint32_t index = metric->getHandle();
+
+    if (index == 0)
+    {
+        if (unused.empty())
+        {
+            index = slots.size();
+            slots.emplace_back();
+        }
+        else
+        {
+            index = unused.back();
+            unused.pop_back();
+        }
+
+        slots[index].metric = metric;
+        slots[index].owner = owner;
+        metric->setHandle(index);
+    }
+
+    return MetricHandle{index, slots[index].generation};
+}
+
+void MetricHandles::release(Metric *metric)
+{
+    uint32_t index = metric->getHandle();
+
+    if (index == 0)
+    {
+        return;
+    }
+
+    Slot &slot = slots[index];
+    slot.metric = nullptr;
+    slot.owner = nullptr;
+    slot.generation++;
+    unused.push_back(index);
+    metric->setHandle(0);
+}
+
+void MetricHandles::read(MetricHandle handle, MetricReading &reading) const
+{
+    Metric *metric = find(handle);
+
+    if (!metric)
+    {
+        reading = MetricReading();
+        return;
+    }
+
+    metric->read(reading);
+    reading.stale = slots[handle.index].owner && slots[handle.index].owner->isStale();
+}
@@ -0,0 +1,161 @@
+/*
+ * File: MetricHandles.h
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#ifndef SRC_TYPES_METRICHANDLES
+#define SRC_TYPES_METRICHANDLES
+
+#include "Metric.h"
+#include <vector>
+
+class Publishable;
+
+/**
+ * @brief A stable reference to a Metric, resolved once from its path.
+ * The handle stays valid across births that keep the Metric, and is invalidated once the Metric is removed.
+ *
+ */
+struct MetricHandle
+{
+    uint32_t index = 0;
+    uint32_t generation = 0;
+
+    /**
+     * @brief Whether the handle was resolved to a Metric. It may have been invalidated since.
+     *
+     * @return true
+     * @return false
+     */
+    bool isResolved() const
+    {
+        return index != 0;
+    }
+};
+
+/**
+ * @brief The value of a Metric read through a handle
+ *
+ */
+struct MetricReading
+{
+    /**
+     * @brief Whether the handle still refers to a Metric
+     *
+     */
+    bool valid = false;
+    /**
+     * @brief Whether the value holds a scalar. False for null values and values that aren't scalars.
+     *
+     */
+    bool hasValue = false;
+    uint32_t datatype = METRIC_DATA_TYPE_UNKNOWN;
+    int32_t quality = QUALITY_GOOD;
+    /**
+     * @brief Whether the Node or Device of the Metric is stale or hasn't been reborn since it was restored,
+     * so the value is the last one known rather than a current one
+     *
+     */
+    bool stale = false;
+    /**
+     * @brief The timestamp of the last value, or 0 if it had none
+     *
+     */
+    uint64_t timestamp = 0;
+    ScalarValue value = {};
+};
+
+/**
+ * @brief A table of handles to Metrics.
+ * Slots are reused once their Metric is removed, their generation is advanced so older handles no longer match.
+ *
+ */
+class MetricHandles
+{
+private:
+    struct Slot
+    {
+        Metric *metric = nullptr;
+        /**
+         * @brief The Node or Device the Metric belongs to
+         *
+         */
+        Publishable *owner = nullptr;
+        uint32_t generation = 1;
+    };
+
+    /**
+     * @brief The slots of the table, the first slot is never used so a zero index is never valid
+     *
+     */
+    std::vector<Slot> slots = std::vector<Slot>(1);
+    std::vector<uint32_t> unused;
+
+public:
+    /**
+     * @brief Gets the handle of a Metric, assigning it a slot if it has none
+     *
+     * @param metric
+     * @param owner The Node or Device the Metric belongs to
+     * @return MetricHandle
+     */
+    MetricHandle bind(Metric *metric, Publishable *owner);
+    /**
+     * @brief Invalidates the handle of a Metric before it is destroyed
+     *
+     * @param metric
+     */
+    void release(Metric *metric);
+    /**
+     * @brief Finds the Metric a handle refers to
+     *
+     * @param handle
+     * @return Metric* The Metric, or nullptr if the handle was invalidated
+     */
+    Metric *find(MetricHandle handle) const
+    {
+        if (handle.index == 0 || handle.index >= slots.size())
+        {
+            return nullptr;
+        }
+
+        const Slot &slot = slots[handle.index];
+        return slot.generation == handle.generation ? slot.metric : nullptr;
+    }
+    /**
+     * @brief Reads the value, timestamp and Quality of the Metric a handle refers to,
+     * along with whether its Node or Device is stale
+     *
+     * @param handle
+     * @param reading
+     */
+    void read(MetricHandle handle, MetricReading &reading) const;
+};
+
+#endif /* SRC_TYPES_METRICHANDLES */
@@ -0,0 +1,689 @@
+/*
+ * File: MetricValue.cpp
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#include "MetricValue.h"
+#include "Template.h"
+#include "DataSet.h"
+#include "Bytes.h"
+#include "ArrayValue.h"
+#include <cstring>
+#include <cstdlib>
+#include <cmath>
+
+enum class ValueSlot
+{
+    INT,
+    LONG,
+    FLOAT,
+    DOUBLE,
+    BOOLEAN,
+    STRING,
+    OTHER
+};
+
+/**
+ * @brief Which member of the tahu value unions a datatype is stored in.
+ * Metric and Property datatypes share the same values for scalar types.
+ *
+ */
+static ValueSlot slotOf(uint32_t type)
+{
+    switch (type)
+    {
+    case METRIC_DATA_TYPE_INT8:
+    case METRIC_DATA_TYPE_UINT8:
+    case METRIC_DATA_TYPE_INT16:
+    case METRIC_DATA_TYPE_UINT16:
+    case METRIC_DATA_TYPE_INT32:
+    case METRIC_DATA_TYPE_UINT32:
+        return ValueSlot::INT;
+    case METRIC_DATA_TYPE_INT64:
+    case METRIC_DATA_TYPE_UINT64:
+    case METRIC_DATA_TYPE_DATETIME:
+        return ValueSlot::LONG;
+    case METRIC_DATA_TYPE_FLOAT:
+        return ValueSlot::FLOAT;
+    case METRIC_DATA_TYPE_DOUBLE:
+        return ValueSlot::DOUBLE;
+    case METRIC_DATA_TYPE_BOOLEAN:
+        return ValueSlot::BOOLEAN;
+    case METRIC_DATA_TYPE_STRING:
+    case METRIC_DATA_TYPE_TEXT:
+    case METRIC_DATA_TYPE_UUID:
+        return ValueSlot::STRING;
+    default:
+        return ValueSlot::OTHER;
+    }
+}
+
+static inline bool isBytes(uint32_t type)
+{
+    return type == METRIC_DATA_TYPE_BYTES || type == METRIC_DATA_TYPE_FILE;
+}
+
+static inline bool isArray(uint32_t type)
+{
+    return type >= METRIC_DATA_TYPE_INT8ARRAY && type <= METRIC_DATA_TYPE_DATETIMEARRAY;
+}
+
+MetricValue::MetricValue()
+{
+    memset(&value, 0, sizeof(MetricValueUnion));
+}
+
+MetricValue::MetricValue(MetricValue &&other) noexcept : type(other.type), null(other.null), changed(other.changed), value(other.value)
+{
+    other.null = true;
+    memset(&other.value, 0, sizeof(MetricValueUnion));
+}
+
+MetricValue &MetricValue::operator=(MetricValue &&other) noexcept
+{
+    if (this != &other)
+    {
+        clear();
+        type = other.type;
+        null = other.null;
+        changed = other.changed;
+        value = other.value;
+        other.null = true;
+        memset(&other.value, 0, sizeof(MetricValueUnion));
+    }
+    return *this;
+}
+
+MetricValue::~MetricValue()
+{
+    clear();
+}
+
+void MetricValue::clear()
+{
+    if (!null)
+    {
+        if (slotOf(type) == ValueSlot::STRING && value.stringValue)
+        {
+            free(value.stringValue);
+        }
+        else if (type == METRIC_DATA_TYPE_TEMPLATE && value.templateValue)
+        {
+            delete value.templateValue;
+        }
+        else if (type == METRIC_DATA_TYPE_DATASET && value.dataSetValue)
+        {
+            delete value.dataSetValue;
+        }
+        else if (isBytes(type) && value.bytesValue)
+        {
+            delete value.bytesValue;
+        }
+        else if (isArray(type) && value.arrayValue)
+        {
+            delete value.arrayValue;
+        }
+    }
+
+    null = true;
+    memset(&value, 0, sizeof(MetricValueUnion));
+}
+
+void MetricValue::reset()
+{
+    clear();
+    type = METRIC_DATA_TYPE_UNKNOWN;
+}
+
+template <typename Source>
+bool MetricValue::readValue(Source &source)
+{
+    switch (slotOf(type))
+    {
+    case ValueSlot::INT:
+        value.intValue = source.int_value;
+        break;
+    case ValueSlot::LONG:
+        value.longValue = source.long_value;
+        break;
+    case ValueSlot::FLOAT:
+        value.floatValue = source.float_value;
+        break;
+    case ValueSlot::DOUBLE:
+        value.doubleValue = source.double_value;
+        break;
+    case ValueSlot::BOOLEAN:
+        value.booleanValue = source.boolean_value;
+        break;
+    case ValueSlot::STRING:
+        clear();
+        value.stringValue = source.string_value ? strdup(source.string_value) : nullptr;
+        break;
+    default:
+        return false;
+    }
+
+    null = false;
+    return true;
+}
+
+ParseResult MetricValue::process(tahu::Metric *metric, MetricScope *scope)
+{
+    // Datatypes are only required in births, data messages may leave them out
+    uint32_t datatype = metric->has_datatype ? metric->datatype : type;
+
+    if (datatype != type && type != METRIC_DATA_TYPE_UNKNOWN)
+    {
+        return ParseResult::OUT_OF_SYNC;
+    }
+
+    type = datatype;
+    changed = true;
+
+    if (metric->has_is_null && metric->is_null)
+    {
+        clear();
+        return ParseResult::OK;
+    }
+
+    if (type == METRIC_DATA_TYPE_TEMPLATE)
+    {
+        return processTemplate(metric, scope);
+    }
+
+    if (isBytes(type))
+    {
+        if (metric->which_value != org_eclipse_tahu_protobuf_Payload_Metric_bytes_value_tag || !metric->value.bytes_value)
+        {
+            clear();
+            return ParseResult::OK;
+        }
+
+        bool created = null;
+        if (null)
+        {
+            std::function<void()> onEvicted;
+            if (scope && scope->metric && scope->evicted)
+            {
+                onEvicted = std::bind(scope->evicted, scope->metric);
+            }
+
+            value.bytesValue = new StoredBytes(scope ? scope->bytes : nullptr, onEvicted);
+            null = false;
+        }
+
+        // Ownership of the decoded bytes moves to the value, so the payload no longer frees them
+        changed = value.bytesValue->take(metric->value.bytes_value) || created;
+        metric->value.bytes_value = nullptr;
+        return ParseResult::OK;
+    }
+
+    if (isArray(type))
+    {
+        if (metric->which_value != org_eclipse_tahu_protobuf_Payload_Metric_bytes_value_tag || !metric->value.bytes_value)
+        {
+            clear();
+            return ParseResult::OK;
+        }
+
+        // Arrays are kept between values so only the changed elements are flagged
+        if (null)
+        {
+            value.arrayValue = new ArrayValue(type, scope ? scope->arrayDeltas : nullptr);
+            null = false;
+            value.arrayValue->process(metric->value.bytes_value);
+            return ParseResult::OK;
+        }
+
+        changed = value.arrayValue->process(metric->value.bytes_value);
+        return ParseResult::OK;
+    }
+
+    if (type == METRIC_DATA_TYPE_DATASET)
+    {
+        if (metric->which_value != org_eclipse_tahu_protobuf_Payload_Metric_dataset_value_tag)
+        {
+            clear();
+            return ParseResult::OK;
+        }
+
+        // The DataSet is kept between values so it can be compared with the previous value
+        if (null)
+        {
+            value.dataSetValue = new DataSet();
+            null = false;
+            value.dataSetValue->process(&metric->value.dataset_value);
+            return ParseResult::OK;
+        }
+
+        changed = value.dataSetValue->process(&metric->value.dataset_value);
+        return ParseResult::OK;
+    }
+
+    if (!readValue(metric->value))
+    {
+        clear();
+    }
+
+    return ParseResult::OK;
+}
+
+ParseResult MetricValue::processTemplate(tahu::Metric *metric, MetricScope *scope)
+{
+    if (metric->which_value != org_eclipse_tahu_protobuf_Payload_Metric_template_value_tag)
+    {
+        clear();
+        return ParseResult::OK;
+    }
+
+    tahu::Template *source = &metric->value.template_value;
+    const char *reference = source->template_ref;
+
+    if (!null && reference && value.templateValue->getDefinition().getName().compare(reference) != 0)
+    {
+        clear();
+    }
+
+    bool created = null;
+    if (null)
+    {
+        std::shared_ptr<const TemplateDefinition> definition;
+
+        if (scope && scope->templates && reference)
+        {
+            definition = scope->templates->find(reference);
+        }
+
+        // Instances can only be created from a known definition, partial updates don't include the reference
+        if (!definition)
+        {
+            return ParseResult::OUT_OF_SYNC;
+        }
+
+        value.templateValue = new TemplateInstance(definition);
+        null = false;
+    }
+
+    bool membersChanged;
+    ParseResult result = value.templateValue->process(source, scope, membersChanged);
+    changed = membersChanged || created;
+    return result;
+}
+
+ParseResult MetricValue::process(tahu::Parameter *parameter)
+{
+    uint32_t datatype = parameter->has_type ? parameter->type : type;
+
+    if (datatype != type && type != METRIC_DATA_TYPE_UNKNOWN)
+    {
+        return ParseResult::OUT_OF_SYNC;
+    }
+
+    type = datatype;
+
+    if (!readValue(parameter->value))
+    {
+        clear();
+    }
+
+    return ParseResult::OK;
+}
+
+void MetricValue::appendTo(tahu::Metric *metric, bool force)
+{
+    metric->datatype = type;
+    metric->has_datatype = true;
+    metric->has_is_null = metric->is_null = null;
+
+    if (null)
+    {
+        return;
+    }
+
+    switch (slotOf(type))
+    {
+    case ValueSlot::INT:
+        metric->which_value = org_eclipse_tahu_protobuf_Payload_Metric_int_value_tag;
+        metric->value.int_value = value.intValue;
+        break;
+    case ValueSlot::LONG:
+        metric->which_value = org_eclipse_tahu_protobuf_Payload_Metric_long_value_tag;
+        metric->value.long_value = value.longValue;
+        break;
+    case ValueSlot::FLOAT:
+        metric->which_value = org_eclipse_tahu_protobuf_Payload_Metric_float_value_tag;
+        metric->value.float_value = value.floatValue;
+        break;
+    case ValueSlot::DOUBLE:
+        metric->which_value = org_eclipse_tahu_protobuf_Payload_Metric_double_value_tag;
+        metric->value.double_value = value.doubleValue;
+        break;
+    case ValueSlot::BOOLEAN:
+        metric->which_value = org_eclipse_tahu_protobuf_Payload_Metric_boolean_value_tag;
+        metric->value.boolean_value = value.booleanValue;
+        break;
+    case ValueSlot::STRING:
+        if (value.stringValue)
+        {
+            metric->which_value = org_eclipse_tahu_protobuf_Payload_Metric_string_value_tag;
+            metric->value.string_value = strdup(value.stringValue);
+        }
+        else
+        {
+            metric->has_is_null = metric->is_null = true;
+        }
+        break;
+    default:
+        if (type == METRIC_DATA_TYPE_TEMPLATE)
+        {
+            metric->which_value = org_eclipse_tahu_protobuf_Payload_Metric_template_value_tag;
+            value.templateValue->appendTo(&metric->value.template_value, force);
+        }
+        else if (type == METRIC_DATA_TYPE_DATASET)
+        {
+            metric->which_value = org_eclipse_tahu_protobuf_Payload_Metric_dataset_value_tag;
+            value.dataSetValue->appendTo(&metric->value.dataset_value);
+        }
+        else if (isArray(type))
+        {
+            value.arrayValue->appendTo(metric, force);
+        }
+        else if (isBytes(type))
+        {
+            auto bytes = value.bytesValue->view();
+            if (!bytes)
+            {
+                metric->has_is_null = metric->is_null = true;
+                break;
+            }
+
+            // Payloads own their values, so the bytes are copied into the Payload
+            pb_bytes_array_t *copy = (pb_bytes_array_t *)malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(bytes->size));
+            copy->size = bytes->size;
+            memcpy(copy->bytes, bytes->bytes, bytes->size);
+            metric->which_value = org_eclipse_tahu_protobuf_Payload_Metric_bytes_value_tag;
+            metric->value.bytes_value = copy;
+        }
+        break;
+    }
+}
+
+void MetricValue::appendTo(tahu::Parameter *parameter)
+{
+    parameter->type = type;
+    parameter->has_type = true;
+
+    if (null)
+    {
+        return;
+    }
+
+    switch (slotOf(type))
+    {
+    case ValueSlot::INT:
+        parameter->which_value = org_eclipse_tahu_protobuf_Payload_Template_Parameter_int_value_tag;
+        parameter->value.int_value = value.intValue;
+        break;
+    case ValueSlot::LONG:
+        parameter->which_value = org_eclipse_tahu_protobuf_Payload_Template_Parameter_long_value_tag;
+        parameter->value.long_value = value.longValue;
+        break;
+    case ValueSlot::FLOAT:
+        parameter->which_value = org_eclipse_tahu_protobuf_Payload_Template_Parameter_float_value_tag;
+        parameter->value.float_value = value.floatValue;
+        break;
+    case ValueSlot::DOUBLE:
+        parameter->which_value = org_eclipse_tahu_protobuf_Payload_Template_Parameter_double_value_tag;
+        parameter->value.double_value = value.doubleValue;
+        break;
+    case ValueSlot::BOOLEAN:
+        parameter->which_value = org_eclipse_tahu_protobuf_Payload_Template_Parameter_boolean_value_tag;
+        parameter->value.boolean_value = value.booleanValue;
+        break;
+    case ValueSlot::STRING:
+        if (value.stringValue)
+        {
+            parameter->which_value = org_eclipse_tahu_protobuf_Payload_Template_Parameter_string_value_tag;
+            parameter->value.string_value = strdup(value.stringValue);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+uint32_t MetricValue::getType()
+{
+    return type;
+}
+
+bool MetricValue::isNull()
+{
+    return null;
+}
+
+/**
+ * @brief FNV-1a hash of a string, used to compare strings without keeping a copy of the last changed value
+ *
+ */
+static uint64_t hashOf(const char *value)
+{
+    uint64_t hash = 0xcbf29ce484222325;
+    for (; *value; value++)
+    {
+        hash = (hash ^ (uint8_t)*value) * 0x100000001b3;
+    }
+    return hash;
+}
+
+bool MetricValue::readScalar(ScalarValue &scalar)
+{
+    if (null)
+    {
+        return false;
+    }
+
+    switch (type)
+    {
+    case METRIC_DATA_TYPE_INT8:
+        scalar.intValue = (int8_t)value.intValue;
+        break;
+    case METRIC_DATA_TYPE_INT16:
+        scalar.intValue = (int16_t)value.intValue;
+        break;
+    case METRIC_DATA_TYPE_INT32:
+        scalar.intValue = (int32_t)value.intValue;
+        break;
+    case METRIC_DATA_TYPE_INT64:
+        scalar.intValue = (int64_t)value.longValue;
+        break;
+    case METRIC_DATA_TYPE_UINT8:
+    case METRIC_DATA_TYPE_UINT16:
+    case METRIC_DATA_TYPE_UINT32:
+        scalar.uintValue = value.intValue;
+        break;
+    case METRIC_DATA_TYPE_UINT64:
+    case METRIC_DATA_TYPE_DATETIME:
+        scalar.uintValue = value.longValue;
+        break;
+    case METRIC_DATA_TYPE_FLOAT:
+        scalar.doubleValue = value.floatValue;
+        break;
+    case METRIC_DATA_TYPE_DOUBLE:
+        scalar.doubleValue = value.doubleValue;
+        break;
+    case METRIC_DATA_TYPE_BOOLEAN:
+        scalar.booleanValue = value.booleanValue;
+        break;
+    default:
+        return false;
+    }
+
+    return true;
+}
+
+double MetricValue::numeric(uint64_t bits)
+{
+    switch (type)
+    {
+    case METRIC_DATA_TYPE_INT8:
+        return (int8_t)bits;
+    case METRIC_DATA_TYPE_INT16:
+        return (int16_t)bits;
+    case METRIC_DATA_TYPE_INT32:
+        return (int32_t)bits;
+    case METRIC_DATA_TYPE_INT64:
+        return (int64_t)bits;
+    case METRIC_DATA_TYPE_FLOAT:
+    {
+        float value;
+        uint32_t narrow = bits;
+        memcpy(&value, &narrow, sizeof(value));
+        return value;
+    }
+    case METRIC_DATA_TYPE_DOUBLE:
+    {
+        double value;
+        memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+    default:
+        return bits;
+    }
+}
+
+bool MetricValue::update(const Deadband &deadband, uint64_t &reference, bool &hasReference)
+{
+    if (null)
+    {
+        bool changed = hasReference;
+        hasReference = false;
+        return changed;
+    }
+
+    uint64_t bits = 0;
+    ValueSlot slot = slotOf(type);
+
+    switch (slot)
+    {
+    case ValueSlot::INT:
+        bits = value.intValue;
+        break;
+    case ValueSlot::LONG:
+        bits = value.longValue;
+        break;
+    case ValueSlot::FLOAT:
+    {
+        uint32_t narrow;
+        memcpy(&narrow, &value.floatValue, sizeof(narrow));
+        bits = narrow;
+        break;
+    }
+    case ValueSlot::DOUBLE:
+        memcpy(&bits, &value.doubleValue, sizeof(bits));
+        break;
+    case ValueSlot::BOOLEAN:
+        bits = value.booleanValue;
+        break;
+    case ValueSlot::STRING:
+        bits = value.stringValue ? hashOf(value.stringValue) : 0;
+        break;
+    default:
+        // Values compared by their own content keep an empty reference, so a later null is still seen as a change.
+        // Dropped Bytes are already reported as null.
+        reference = 0;
+        hasReference = !isBytes(type) || !value.bytesValue->isEvicted();
+        return changed;
+    }
+
+    bool changed = deadband.mode == ChangeMode::ANY || !hasReference || bits != reference;
+
+    bool isNumeric = slot != ValueSlot::STRING && slot != ValueSlot::BOOLEAN;
+    bool isDeadband = deadband.mode == ChangeMode::ABSOLUTE || deadband.mode == ChangeMode::PERCENT;
+
+    if (changed && hasReference && isNumeric && isDeadband)
+    {
+        double current = numeric(bits);
+        double previous = numeric(reference);
+        double limit = deadband.amount;
+
+        if (deadband.mode == ChangeMode::PERCENT)
+        {
+            limit = fabs(previous) * deadband.amount / 100.0;
+        }
+
+        // NaNs never compare within a deadband, so moving to or from NaN is always a change
+        changed = !(fabs(current - previous) <= limit);
+    }
+
+    if (changed)
+    {
+        reference = bits;
+        hasReference = true;
+    }
+
+    return changed;
+}
+
+void MetricValue::acknowledge()
+{
+    if (null)
+    {
+        return;
+    }
+
+    if (type == METRIC_DATA_TYPE_DATASET)
+    {
+        value.dataSetValue->acknowledge();
+    }
+    else if (isArray(type))
+    {
+        value.arrayValue->acknowledge();
+    }
+}
+
+TemplateInstance *MetricValue::getTemplate()
+{
+    return type == METRIC_DATA_TYPE_TEMPLATE && !null ? value.templateValue : nullptr;
+}
+
+DataSet *MetricValue::getDataSet()
+{
+    return type == METRIC_DATA_TYPE_DATASET && !null ? value.dataSetValue : nullptr;
+}
+
+StoredBytes *MetricValue::getBytes()
+{
+    return isBytes(type) && !null ? value.bytesValue : nullptr;
+}
+
+ArrayValue *MetricValue::getArray()
+{
+    return isArray(type) && !null ? value.arrayValue : nullptr;
+}
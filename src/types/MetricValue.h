@@ -0,0 +1,255 @@
+/*
+ * File: MetricValue.h
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#ifndef SRC_TYPES_METRICVALUE
+#define SRC_TYPES_METRICVALUE
+
+#include "TahuTypes.h"
+#include "CommonTypes.h"
+#include "../utilities/ChangeFilters.h"
+#include <functional>
+
+class TemplateInstance;
+class TemplateLibrary;
+class DataSet;
+class StoredBytes;
+class BytesBudget;
+class ArrayValue;
+class Metric;
+
+/**
+ * @brief The state shared with Metric values while they are processed
+ *
+ */
+struct MetricScope
+{
+    /**
+     * @brief The definitions available to Template values
+     *
+     */
+    TemplateLibrary *templates = nullptr;
+    /**
+     * @brief The budget Bytes and File values are stored within
+     *
+     */
+    BytesBudget *bytes = nullptr;
+    /**
+     * @brief Whether updates to array values only include the changed elements
+     *
+     */
+    const bool *arrayDeltas = nullptr;
+    /**
+     * @brief The model version, advanced for every Metric change
+     *
+     */
+    uint64_t *version = nullptr;
+    /**
+     * @brief The Metric whose value is being processed
+     *
+     */
+    Metric *metric = nullptr;
+    /**
+     * @brief Called with the owning Metric when the budget evicts one of its Bytes values
+     *
+     */
+    std::function<void(Metric *)> evicted;
+};
+
+/**
+ * @brief A scalar value copied out of a Metric.
+ * Signed integers are read as intValue, unsigned integers and DateTimes as uintValue, and Floats and Doubles as doubleValue.
+ *
+ */
+union ScalarValue
+{
+    int64_t intValue;
+    uint64_t uintValue;
+    double doubleValue;
+    bool booleanValue;
+};
+
+/**
+ * @brief The typed value of a Sparkplug Metric, Template member or Template parameter.
+ * Owns any memory allocated for the value.
+ *
+ */
+class MetricValue
+{
+private:
+    uint32_t type = METRIC_DATA_TYPE_UNKNOWN;
+    bool null = true;
+    /**
+     * @brief Whether the last processed DataSet, array, Template or Bytes value differed from the one before it.
+     * Scalars and strings are compared with their reference in update() instead.
+     *
+     */
+    bool changed = true;
+
+    union MetricValueUnion
+    {
+        uint32_t intValue;
+        uint64_t longValue;
+        float floatValue;
+        double doubleValue;
+        bool booleanValue;
+        char *stringValue;
+        TemplateInstance *templateValue;
+        DataSet *dataSetValue;
+        StoredBytes *bytesValue;
+        ArrayValue *arrayValue;
+    } value;
+
+    /**
+     * @brief Processes a Template value, creating the Template instance from its definition if required
+     *
+     * @param metric
+     * @param scope
+     * @return ParseResult
+     */
+    ParseResult processTemplate(tahu::Metric *metric, MetricScope *scope);
+    /**
+     * @brief Reads a scalar value from a tahu value union for the current datatype
+     *
+     * @param source
+     * @return true
+     * @return false The datatype isn't a scalar
+     */
+    template <typename Source>
+    bool readValue(Source &source);
+    /**
+     * @brief Converts the stored bits of a numeric value to a double
+     *
+     * @param bits
+     * @return double
+     */
+    double numeric(uint64_t bits);
+
+protected:
+public:
+    MetricValue();
+    MetricValue(MetricValue &&other) noexcept;
+    MetricValue &operator=(MetricValue &&other) noexcept;
+    MetricValue(const MetricValue &) = delete;
+    MetricValue &operator=(const MetricValue &) = delete;
+    ~MetricValue();
+    /**
+     * @brief Clears the value, freeing any allocated memory. The datatype is kept.
+     *
+     */
+    void clear();
+    /**
+     * @brief Clears the value and the datatype
+     *
+     */
+    void reset();
+    /**
+     * @brief Processes the value of a tahu::Metric.
+     * Bytes and File values take ownership of the decoded bytes, leaving the tahu::Metric without a value.
+     *
+     * @param metric
+     * @param scope The Template definitions and Bytes budget available to the value
+     * @return ParseResult OUT_OF_SYNC if the datatype changed or a Template's definition is unknown
+     */
+    ParseResult process(tahu::Metric *metric, MetricScope *scope = nullptr);
+    /**
+     * @brief Processes the value of a Template parameter
+     *
+     * @param parameter
+     * @return ParseResult
+     */
+    ParseResult process(tahu::Parameter *parameter);
+    /**
+     * @brief Writes the datatype and value to a tahu::Metric
+     *
+     * @param metric
+     * @param force Writes all members of a Template or elements of an array instead of only the changed ones
+     */
+    void appendTo(tahu::Metric *metric, bool force = true);
+    /**
+     * @brief Writes the datatype and value to a Template parameter
+     *
+     * @param parameter
+     */
+    void appendTo(tahu::Parameter *parameter);
+    uint32_t getType();
+    bool isNull();
+    /**
+     * @brief Copies a numeric or Boolean value
+     *
+     * @param scalar
+     * @return true
+     * @return false The value is null or isn't numeric or Boolean
+     */
+    bool readScalar(ScalarValue &scalar);
+    /**
+     * @brief Acknowledges the changes of DataSet and array values once they're published
+     *
+     */
+    void acknowledge();
+    /**
+     * @brief Compares the value with the last changed value, replacing the reference when the value changed.
+     * Values without a reference (Templates, DataSets, arrays, Bytes) report whether the last processed value
+     * differed from the one before it, and only use hasReference to know the previous value wasn't null.
+     *
+     * @param deadband
+     * @param reference The bits of the last changed numeric value, or the hash of the last changed string
+     * @param hasReference Whether the previous value wasn't null, false once the value is null
+     * @return true The value changed
+     * @return false
+     */
+    bool update(const Deadband &deadband, uint64_t &reference, bool &hasReference);
+    /**
+     * @brief Gets the Template instance of a Template value
+     *
+     * @return TemplateInstance* The instance, or nullptr if the value isn't a Template
+     */
+    TemplateInstance *getTemplate();
+    /**
+     * @brief Gets the DataSet of a DataSet value
+     *
+     * @return DataSet* The DataSet, or nullptr if the value isn't a DataSet
+     */
+    DataSet *getDataSet();
+    /**
+     * @brief Gets the stored bytes of a Bytes or File value
+     *
+     * @return StoredBytes* The bytes, or nullptr if the value isn't Bytes or a File
+     */
+    StoredBytes *getBytes();
+    /**
+     * @brief Gets the elements of an array value
+     *
+     * @return ArrayValue* The elements, or nullptr if the value isn't an array
+     */
+    ArrayValue *getArray();
+};
+
+#endif /* SRC_TYPES_METRICVALUE */
@@ -0,0 +1,165 @@
+/*
+ * File: ModelContext.h
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#ifndef SRC_TYPES_MODELCONTEXT
+#define SRC_TYPES_MODELCONTEXT
+
+#include "../utilities/MetricFilters.h"
+#include "../utilities/ChangeFilters.h"
+#include "Bytes.h"
+#include "MetricHandles.h"
+#include "ModelStatistics.h"
+#include "../utilities/TimerWheel.h"
+#include "../utilities/RateLimiter.h"
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#define MAX_QUALITY_CHANGES 65536
+#define STALE_TICK_MS 100
+
+class Node;
+class Publishable;
+
+/**
+ * @brief A change to the Quality of a watched Metric
+ *
+ */
+struct QualityChange
+{
+    /**
+     * @brief The name of the Node (group/node) or Device (group/node/device) the Metric belongs to
+     *
+     */
+    std::string publisher;
+    std::string metric;
+    int32_t previous;
+    int32_t quality;
+    /**
+     * @brief The timestamp of the Metric that changed the Quality, or 0 if it had none
+     *
+     */
+    uint64_t timestamp;
+};
+
+/**
+ * @brief State shared by all Groups, Nodes and Devices managed by a Sparkplug Host
+ *
+ */
+struct ModelContext
+{
+    MetricFilters filters;
+    ChangeFilters deadbands;
+    BytesBudget bytes;
+    /**
+     * @brief Whether updates to array Metrics only include the changed elements
+     *
+     */
+    bool arrayDeltas = false;
+    /**
+     * @brief Filters for the Metrics whose Quality changes are reported
+     *
+     */
+    MetricFilters qualityWatches;
+    /**
+     * @brief Quality changes not yet collected, the oldest are dropped past MAX_QUALITY_CHANGES
+     *
+     */
+    std::deque<QualityChange> qualityChanges;
+    /**
+     * @brief The model version, advanced for every Metric change, birth and death
+     *
+     */
+    uint64_t version = 0;
+    /**
+     * @brief Handles to Metrics resolved for point reads
+     *
+     */
+    MetricHandles handles;
+    /**
+     * @brief The inactivity timers of Nodes and Devices, one tick every STALE_TICK_MS
+     *
+     */
+    TimerWheel timeouts;
+    /**
+     * @brief The inactivity timeout in ticks of Nodes and Devices without their own timeout, 0 for none
+     *
+     */
+    uint32_t defaultTimeout = 0;
+    /**
+     * @brief The inactivity timeouts in ticks of specific Nodes (group/node) and Devices (group/node/device)
+     *
+     */
+    std::unordered_map<std::string, uint32_t> publisherTimeouts;
+    /**
+     * @brief Advanced whenever the timeouts change, so Publishers know to look up their timeout again
+     *
+     */
+    uint32_t timeoutRevision = 1;
+    /**
+     * @brief The statistics of every Group
+     *
+     */
+    ModelStatistics statistics;
+    /**
+     * @brief The rate limit of Nodes without their own limit
+     *
+     */
+    RateLimit defaultLimit;
+    /**
+     * @brief The rate limits of specific Nodes (group/node)
+     *
+     */
+    std::unordered_map<std::string, RateLimit> nodeLimits;
+    /**
+     * @brief Advanced whenever the rate limits change, so Nodes know to look up their limit again
+     *
+     */
+    uint32_t limitRevision = 1;
+    /**
+     * @brief Nodes holding messages over their rate limit, each is given a turn to apply them in order
+     *
+     */
+    std::deque<Node *> deferred;
+    /**
+     * @brief Nodes and Devices whose Bytes values were evicted, their versions are yet to be tracked by their Group
+     *
+     */
+    std::vector<Publishable *> evicted;
+    /**
+     * @brief The time the current batch of messages is applied at, in microseconds of a steady clock
+     *
+     */
+    int64_t now = 0;
+};
+
+#endif /* SRC_TYPES_MODELCONTEXT */
@@ -0,0 +1,73 @@
+/*
+ * File: ModelStatistics.cpp
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#include "ModelStatistics.h"
+
+void ModelStatistics::add(std::atomic<int64_t> ModelStatistics::*counter, int64_t amount)
+{
+    for (ModelStatistics *statistics = this; statistics; statistics = statistics->parent)
+    {
+        (statistics->*counter).fetch_add(amount, std::memory_order_relaxed);
+    }
+}
+
+void ModelStatistics::sample(double seconds)
+{
+    int64_t total = messages.load(std::memory_order_relaxed);
+
+    if (seconds > 0)
+    {
+        messageRate.store((total - sampled) / seconds, std::memory_order_relaxed);
+    }
+
+    sampled = total;
+}
+
+StatisticsSnapshot ModelStatistics::read() const
+{
+    StatisticsSnapshot snapshot;
+
+    snapshot.nodes = nodes.load(std::memory_order_relaxed);
+    snapshot.onlineNodes = onlineNodes.load(std::memory_order_relaxed);
+    snapshot.staleNodes = snapshot.nodes - snapshot.onlineNodes;
+    snapshot.devices = devices.load(std::memory_order_relaxed);
+    snapshot.onlineDevices = onlineDevices.load(std::memory_order_relaxed);
+    snapshot.staleDevices = snapshot.devices - snapshot.onlineDevices;
+    snapshot.messages = messages.load(std::memory_order_relaxed);
+    snapshot.messageRate = messageRate.load(std::memory_order_relaxed);
+    snapshot.rebirths = rebirths.load(std::memory_order_relaxed);
+    snapshot.sequenceErrors = sequenceErrors.load(std::memory_order_relaxed);
+    snapshot.limitedMessages = limitedMessages.load(std::memory_order_relaxed);
+    snapshot.droppedMessages = droppedMessages.load(std::memory_order_relaxed);
+    snapshot.promotedMessages = promotedMessages.load(std::memory_order_relaxed);
+
+    return snapshot;
+}
@@ -0,0 +1,134 @@
+/*
+ * File: ModelStatistics.h
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#ifndef SRC_TYPES_MODELSTATISTICS
+#define SRC_TYPES_MODELSTATISTICS
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief A copy of the statistics of a Group or Sparkplug Host at one point in time
+ *
+ */
+struct StatisticsSnapshot
+{
+    int64_t nodes = 0;
+    int64_t onlineNodes = 0;
+    int64_t staleNodes = 0;
+    int64_t devices = 0;
+    int64_t onlineDevices = 0;
+    int64_t staleDevices = 0;
+    /**
+     * @brief The number of messages received for Nodes and their Devices
+     *
+     */
+    int64_t messages = 0;
+    /**
+     * @brief The messages received per second, measured over the last second
+     *
+     */
+    double messageRate = 0;
+    /**
+     * @brief The number of rebirths requested from Nodes
+     *
+     */
+    int64_t rebirths = 0;
+    int64_t sequenceErrors = 0;
+    /**
+     * @brief The number of data messages received over a Node's rate limit
+     *
+     */
+    int64_t limitedMessages = 0;
+    /**
+     * @brief The number of data messages discarded by rate limits, including deferred messages over the backlog limit
+     *
+     */
+    int64_t droppedMessages = 0;
+    /**
+     * @brief The number of messages taken ahead of a backlog, either lifecycle messages or the messages before them on the same Node
+     *
+     */
+    int64_t promotedMessages = 0;
+};
+
+/**
+ * @brief Statistics of the Nodes and Devices of a Group or Sparkplug Host.
+ * Counters are updated as Nodes and Devices change, along with the counters of the parent,
+ * and can be read from any thread without locking.
+ *
+ */
+struct ModelStatistics
+{
+    std::atomic<int64_t> nodes{0};
+    std::atomic<int64_t> onlineNodes{0};
+    std::atomic<int64_t> devices{0};
+    std::atomic<int64_t> onlineDevices{0};
+    std::atomic<int64_t> messages{0};
+    std::atomic<int64_t> rebirths{0};
+    std::atomic<int64_t> sequenceErrors{0};
+    std::atomic<int64_t> limitedMessages{0};
+    std::atomic<int64_t> droppedMessages{0};
+    std::atomic<int64_t> promotedMessages{0};
+    std::atomic<double> messageRate{0};
+    /**
+     * @brief The statistics that also include these, nullptr if there are none
+     *
+     */
+    ModelStatistics *parent = nullptr;
+    /**
+     * @brief The number of messages when the message rate was last sampled
+     *
+     */
+    int64_t sampled = 0;
+
+    /**
+     * @brief Adds to a counter of these statistics and all their parents
+     *
+     * @param counter
+     * @param amount
+     */
+    void add(std::atomic<int64_t> ModelStatistics::*counter, int64_t amount);
+    /**
+     * @brief Updates the message rate from the messages received since the last sample
+     *
+     * @param seconds The time since the last sample
+     */
+    void sample(double seconds);
+    /**
+     * @brief Copies the statistics
+     *
+     * @return StatisticsSnapshot
+     */
+    StatisticsSnapshot read() const;
+};
+
+#endif /* SRC_TYPES_MODELSTATISTICS */
@@ -30,6 +30,9 @@
  */
 
 #include "Node.h"
+#include <cstring>
+#include <memory>
+#include <unordered_set>
 
 #define DEBUGGING 1
 #ifdef DEBUGGING
@@ -40,16 +43,144 @@
 #define LOGGER(out, ...)
 #endif
 
-ParseResult Node::process(SparkplugTopic &topic, tahu::Payload *payload)
+/**
+ * @brief Reads the bdSeq Metric of a birth or death payload
+ *
+ * @param payload
+ * @param bdSeq
+ * @return true
+ * @return false The payload has no bdSeq
+ */
+static bool readBdSeq(tahu::Payload *payload, uint64_t &bdSeq)
+{
+    for (size_t i = 0; i < payload->metrics_count; i++)
+    {
+        tahu::Metric &metric = payload->metrics[i];
+        if (!metric.name || strcmp(metric.name, BDSEQ_METRIC) != 0)
+        {
+            continue;
+        }
+
+        switch (metric.which_value)
+        {
+        case org_eclipse_tahu_protobuf_Payload_Metric_long_value_tag:
+            bdSeq = metric.value.long_value;
+            return true;
+        case org_eclipse_tahu_protobuf_Payload_Metric_int_value_tag:
+            bdSeq = metric.value.int_value;
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    return false;
+}
+
+Node::Node(std::string name, ModelContext *context) : Publishable(name, context)
+{
+    useTemplates(&library);
+    usePool(&metrics);
+    DataCollection<Device>::factory = [this, context](std::string &name)
+    {
+        Device *device = devices.create(name, context);
+        device->useTemplates(&library);
+        device->usePool(&metrics);
+        device->joinSession(&session);
+        device->useStatistics(getStatistics());
+        return device;
+    };
+    DataCollection<Device>::destroy = [this](Device *device)
+    {
+        device->useStatistics(nullptr);
+        devices.destroy(device);
+    };
+}
+
+Node::~Node()
+{
+    for (auto &message : deferred)
+    {
+        free_payload(message.payload);
+        free(message.payload);
+    }
+
+    if (queued)
+    {
+        std::erase(context->deferred, this);
+    }
+
+    // Devices and Metrics are allocated from the Node's pools, so they must be released before the pools are
+    DataCollection<Device>::clear();
+    DataCollection<Metric>::clear();
+}
+
+ParseResult Node::process(SparkplugTopic &topic, tahu::Payload *payload, PayloadReader *reader, int64_t received)
 {
+    if (received != 0)
+    {
+        latency.recordTransit(payload->has_timestamp ? payload->timestamp : 0, received);
+    }
+
+    if (statistics)
+    {
+        statistics->add(&ModelStatistics::messages, 1);
+    }
+
     if (topic.isCommand())
     {
         return ParseResult::OK;
     }
 
+    // Births and deaths aren't limited, so data held back before them is applied first to keep the order
+    ParseResult flushed = ParseResult::OK;
+    if (!topic.isData() && !deferred.empty())
+    {
+        flushed = flush(true);
+    }
+
     if (topic.isBirth() && !topic.isDevice())
     {
         sequence = 0;
+        awaitingBirth = false;
+        library.clear();
+        hasBdSeq = readBdSeq(payload, bdSeq);
+    }
+
+    if (topic.isDeath() && !topic.isDevice())
+    {
+        uint64_t deathSeq;
+        if (hasBdSeq && readBdSeq(payload, deathSeq) && deathSeq != bdSeq)
+        {
+            LOGGER("Ignoring a death from an earlier session of %s/%s. Expected bdSeq %lu. Received: %lu.\n",
+                   topic.getGroup().c_str(),
+                   topic.getNode().c_str(),
+                   bdSeq, deathSeq);
+            return ParseResult::OK;
+        }
+    }
+
+    if (awaitingBirth)
+    {
+        if (topic.isDeath() && !topic.isDevice())
+        {
+            // The death matched the restored bdSeq, or the Node had none, ending the restored session
+            awaitingBirth = false;
+        }
+        else
+        {
+            // Restored aliases and sequence may belong to an earlier session, so nothing is applied until the NBIRTH
+            int64_t now = context ? context->now : 0;
+            if (rebirthRequested && now - rebirthRequestedAt < RESTORED_REBIRTH_INTERVAL_US)
+            {
+                return ParseResult::OK;
+            }
+
+            LOGGER("Requesting a rebirth of restored %s/%s.\n", topic.getGroup().c_str(), topic.getNode().c_str());
+            rebirthRequested = true;
+            rebirthRequestedAt = now;
+            return ParseResult::OUT_OF_SYNC;
+        }
     }
 
     if (payload->has_seq && sequence != payload->seq)
@@ -58,38 +189,333 @@ ParseResult Node::process(SparkplugTopic &topic, tahu::Payload *payload)
                topic.getGroup().c_str(),
                topic.getNode().c_str(),
                sequence, payload->seq);
+        if (statistics)
+        {
+            statistics->add(&ModelStatistics::sequenceErrors, 1);
+        }
         return ParseResult::OUT_OF_SYNC;
     }
 
     sequence += 1;
 
+    if (topic.isData() && (!deferred.empty() || !admit(payload, reader)))
+    {
+        limited++;
+        if (statistics)
+        {
+            statistics->add(&ModelStatistics::limitedMessages, 1);
+        }
+
+        if (limiter.getLimit().policy != LimitPolicy::DROP)
+        {
+            return ParseResult::LIMITED;
+        }
+
+        if (statistics)
+        {
+            statistics->add(&ModelStatistics::droppedMessages, 1);
+        }
+        return ParseResult::OK;
+    }
+
+    ParseResult result = apply(topic, payload, reader, received);
+    return flushed == ParseResult::OUT_OF_SYNC && !topic.isBirth() ? flushed : result;
+}
+
+ParseResult Node::apply(SparkplugTopic &topic, tahu::Payload *payload, PayloadReader *reader, int64_t received)
+{
+    ParseResult result;
+
     if (!topic.isDevice())
     {
-        ParseResult result = Publishable::process(topic, payload);
+        result = Publishable::process(topic, payload, reader);
         if (result == ParseResult::OUT_OF_SYNC)
         {
             // Rebirth;
         }
-        return result;
+        track(Publishable::getVersion());
     }
     else
     {
         auto deviceSource = std::string(name + "/" + topic.getDevice());
         auto device = DataCollection<Device>::get(deviceSource);
-        ParseResult result = device->process(topic, payload);
+        result = device->process(topic, payload, reader);
         if (result == ParseResult::OUT_OF_SYNC)
         {
             // Rebirth;
         }
+        // Messages from any Device show the Node is still connected
+        refresh();
+        track(device->getVersion());
+    }
+
+    // Deferred messages are recorded once they're applied, so processing includes the time they were held
+    if (received != 0)
+    {
+        latency.recordProcessing(received, LatencyTracker::now());
+    }
+
+    return result;
+}
+
+bool Node::admit(tahu::Payload *payload, PayloadReader *reader)
+{
+    if (!context)
+    {
+        return true;
+    }
+
+    if (limitRevision != context->limitRevision)
+    {
+        auto match = context->nodeLimits.find(name);
+        limiter.configure(match != context->nodeLimits.end() ? match->second : context->defaultLimit, context->now);
+        limitRevision = context->limitRevision;
+    }
+
+    if (!limiter.isLimited())
+    {
+        return true;
+    }
+
+    size_t count = 0;
+    if (limiter.countsMetrics())
+    {
+        count = reader ? reader->count() : payload->metrics_count;
+    }
+
+    return limiter.admit(count, context->now);
+}
+
+void Node::defer(SparkplugTopic &topic, tahu::Payload *payload, mqtt::const_message_ptr source, int64_t received, std::unique_ptr<PayloadReader> reader)
+{
+    if (deferred.size() >= MAX_DEFERRED_MESSAGES)
+    {
+        discard(deferred.front());
+        deferred.pop_front();
+    }
+
+    deferred.push_back({topic, payload, source, received, std::move(reader)});
+
+    if (!queued)
+    {
+        context->deferred.push_back(this);
+        queued = true;
+    }
+}
+
+void Node::discard(DeferredMessage &message)
+{
+    if (statistics)
+    {
+        statistics->add(&ModelStatistics::droppedMessages, 1);
+    }
+    free_payload(message.payload);
+    free(message.payload);
+}
+
+PayloadReader *Node::readerOf(DeferredMessage &message)
+{
+    if (message.source && !message.reader)
+    {
+        const mqtt::binary &raw = message.source->get_payload();
+        message.reader.reset(new PayloadReader((const uint8_t *)raw.data(), raw.length()));
+    }
+
+    return message.reader.get();
+}
+
+size_t Node::count(DeferredMessage &message)
+{
+    PayloadReader *reader = readerOf(message);
+    return reader ? reader->count() : message.payload->metrics_count;
+}
+
+ParseResult Node::apply(DeferredMessage &message)
+{
+    ParseResult result = apply(message.topic, message.payload, readerOf(message), message.received);
+
+    free_payload(message.payload);
+    free(message.payload);
+    return result;
+}
+
+ParseResult Node::flush(bool all)
+{
+    ParseResult result = ParseResult::OK;
+
+    if (limiter.getLimit().policy != LimitPolicy::COALESCE)
+    {
+        while (!deferred.empty())
+        {
+            DeferredMessage &message = deferred.front();
+
+            if (!all && !admit(message.payload, readerOf(message)))
+            {
+                break;
+            }
+
+            if (apply(message) == ParseResult::OUT_OF_SYNC)
+            {
+                result = ParseResult::OUT_OF_SYNC;
+            }
+            deferred.pop_front();
+        }
+
         return result;
     }
+
+    if (!all)
+    {
+        // The backlog needs tokens for all of its messages and Metrics, even though fewer Metrics are applied
+        size_t metrics = 0;
+        if (limiter.countsMetrics())
+        {
+            for (auto &message : deferred)
+            {
+                metrics += count(message);
+            }
+        }
+
+        if (!limiter.ready(context->now, deferred.size(), metrics))
+        {
+            return result;
+        }
+    }
+
+    // Newest first, so each Metric is applied once with its last value
+    std::unordered_set<const Metric *> applied;
+    Publishable::coalesce(&applied);
+    DataCollection<Device>::each([&applied](Device *device)
+                                 { device->coalesce(&applied); });
+
+    for (auto message = deferred.rbegin(); message != deferred.rend(); ++message)
+    {
+        if (apply(*message) == ParseResult::OUT_OF_SYNC)
+        {
+            result = ParseResult::OUT_OF_SYNC;
+        }
+    }
+
+    Publishable::coalesce(nullptr);
+    DataCollection<Device>::each([](Device *device)
+                                 { device->coalesce(nullptr); });
+
+    // Every held message is charged, but only the Metrics that were applied
+    limiter.charge(deferred.size(), applied.size());
+    deferred.clear();
+
+    return result;
 }
 
-void Node::appendTo(std::vector<PublishableUpdate> &payloads, bool force)
+ParseResult Node::release()
 {
-    Publishable::appendTo(payloads, force);
-    DataCollection<Device>::each([&payloads, force](Device *device)
-                                 { device->appendTo(payloads, force); });
+    ParseResult result = flush(false);
+
+    queued = !deferred.empty();
+    if (queued)
+    {
+        context->deferred.push_back(this);
+    }
+
+    return result;
+}
+
+uint64_t Node::getLimited()
+{
+    return limited;
+}
+
+Device *Node::findDevice(const std::string &device)
+{
+    return DataCollection<Device>::find(name + "/" + device);
+}
+
+LatencyTracker &Node::getLatency()
+{
+    return latency;
+}
+
+void Node::track(uint64_t version)
+{
+    if (version > changed)
+    {
+        changed = version;
+    }
+}
+
+uint64_t Node::getVersion()
+{
+    return changed;
+}
+
+void Node::appendSince(std::vector<PublishableUpdate> &payloads, uint64_t since, uint64_t subscribers)
+{
+    if (changed <= since)
+    {
+        return;
+    }
+
+    Publishable::appendSince(payloads, since, subscribers);
+    DataCollection<Device>::each([&payloads, since, subscribers](Device *device)
+                                 { device->appendSince(payloads, since, subscribers); });
+}
+
+void Node::appendTo(std::vector<PublishableUpdate> &payloads, bool force, uint64_t subscribers)
+{
+    Publishable::appendTo(payloads, force, subscribers);
+    DataCollection<Device>::each([&payloads, force, subscribers](Device *device)
+                                 { device->appendTo(payloads, force, subscribers); });
+}
+
+void Node::subscribe()
+{
+    Publishable::subscribe();
+    DataCollection<Device>::each([](Device *device)
+                                 { device->subscribe(); });
+}
+
+void Node::restore(const std::string &device, tahu::Payload *payload)
+{
+    if (device.empty())
+    {
+        Publishable::restore(payload);
+        awaitingBirth = true;
+        rebirthRequested = false;
+        hasBdSeq = readBdSeq(payload, bdSeq);
+        track(Publishable::getVersion());
+        return;
+    }
+
+    auto deviceSource = std::string(name + "/" + device);
+    Device *target = DataCollection<Device>::get(deviceSource);
+    target->restore(payload);
+    track(target->getVersion());
+}
+
+void Node::snapshot(SnapshotWriter &writer)
+{
+    tahu::Payload *payload = Publishable::snapshot();
+
+    if (!payload)
+    {
+        return;
+    }
+
+    writer.add(name, payload);
+    free_payload(payload);
+    free(payload);
+
+    DataCollection<Device>::each(
+        [&writer](Device *device)
+        {
+            tahu::Payload *payload = device->snapshot();
+            if (payload)
+            {
+                writer.add(device->getName(), payload);
+                free_payload(payload);
+                free(payload);
+            }
+        });
 }
 
 inline bool Node::isDevice()
@@ -33,21 +33,158 @@
 #define SRC_TYPES_NODE
 
 #include "Publishable.h"
+#include "../utilities/Latency.h"
 #include "Device.h"
+#include "../utilities/Snapshot.h"
 #include "../DataCollection.h"
+#include "../utilities/RateLimiter.h"
+#include <deque>
 #include <map>
 #include <string>
 
+#define BDSEQ_METRIC "bdSeq"
+#define MAX_DEFERRED_MESSAGES 1024
+#define RESTORED_REBIRTH_INTERVAL_US 30000000
+
+/**
+ * @brief A data message held back by a Node's rate limit
+ *
+ */
+struct DeferredMessage
+{
+    SparkplugTopic topic;
+    tahu::Payload *payload;
+    /**
+     * @brief The encoded message, when only the header of the payload has been decoded
+     *
+     */
+    mqtt::const_message_ptr source;
+    /**
+     * @brief When the message was received in microseconds since the epoch, 0 if unknown
+     *
+     */
+    int64_t received;
+    /**
+     * @brief The indexed Metrics of the encoded message, created when they're first read
+     *
+     */
+    std::unique_ptr<PayloadReader> reader;
+};
+
 class Node : public Publishable, DataCollection<Device>
 {
 
 private:
     uint8_t sequence = 0;
+    /**
+     * @brief Whether the Node was restored from a snapshot and hasn't been reborn since.
+     * It may have been reborn while the host was down, so its data isn't applied until its NBIRTH.
+     *
+     */
+    bool awaitingBirth = false;
+    bool rebirthRequested = false;
+    /**
+     * @brief When a rebirth was last requested for the restored Node, in microseconds on the context's clock
+     *
+     */
+    int64_t rebirthRequestedAt = 0;
+    /**
+     * @brief The bdSeq of the current session, deaths with a different bdSeq are from an earlier session
+     *
+     */
+    uint64_t bdSeq = 0;
+    bool hasBdSeq = false;
+    TemplateLibrary library;
+    /**
+     * @brief The Metrics of the Node and its Devices are allocated together, and released with the Node
+     *
+     */
+    ObjectPool<Metric> metrics;
+    ObjectPool<Device> devices;
+    /**
+     * @brief The latest model version of the Node, its Devices or any of their Metrics
+     *
+     */
+    uint64_t changed = 0;
+    LatencyTracker latency;
+    RateLimiter limiter;
+    /**
+     * @brief The revision of the context's rate limits the limiter was configured from
+     *
+     */
+    uint32_t limitRevision = 0;
+    std::deque<DeferredMessage> deferred;
+    /**
+     * @brief Whether the Node is waiting in the context's list of Nodes with deferred messages
+     *
+     */
+    bool queued = false;
+    /**
+     * @brief The number of data messages received over the rate limit
+     *
+     */
+    uint64_t limited = 0;
+
+    /**
+     * @brief Applies a message that passed the sequence check to the Node or one of its Devices
+     *
+     * @param topic
+     * @param payload
+     * @param reader
+     * @param received When the message was received in microseconds since the epoch, 0 if unknown
+     * @return ParseResult
+     */
+    ParseResult apply(SparkplugTopic &topic, tahu::Payload *payload, PayloadReader *reader, int64_t received);
+    /**
+     * @brief Applies a deferred message and releases it
+     *
+     * @param message
+     * @return ParseResult
+     */
+    ParseResult apply(DeferredMessage &message);
+    /**
+     * @brief Whether a data message is within the rate limit, taking its tokens
+     *
+     * @param payload
+     * @param reader
+     * @return true
+     * @return false
+     */
+    bool admit(tahu::Payload *payload, PayloadReader *reader);
+    /**
+     * @brief Applies deferred messages, coalescing them if that's the Node's policy
+     *
+     * @param all Applies every deferred message regardless of the rate limit
+     * @return ParseResult OUT_OF_SYNC if any of the messages requires a rebirth
+     */
+    ParseResult flush(bool all);
+    /**
+     * @brief Discards a deferred message, counting it as dropped
+     *
+     * @param message
+     */
+    void discard(DeferredMessage &message);
+    /**
+     * @brief Gets a reader over the encoded Metrics of a deferred message
+     *
+     * @param message
+     * @return PayloadReader* nullptr if the message was fully decoded
+     */
+    PayloadReader *readerOf(DeferredMessage &message);
+    /**
+     * @brief Counts the Metrics of a deferred message
+     *
+     * @param message
+     * @return size_t
+     */
+    size_t count(DeferredMessage &message);
 
 protected:
 public:
     Node(){};
     Node(std::string name) : Publishable(name){};
+    Node(std::string name, ModelContext *context);
+    ~Node();
     /**
      * @brief Processes a Payload that has come from a topic
      * Will validate the sequence and sparkplug payload.
@@ -55,16 +192,45 @@ public:
      *
      * @param topic
      * @param payload
+     * @param reader A reader over the encoded payload when only its header has been decoded
+     * @param received When the message was received in microseconds since the epoch, recording its latencies.
+     * 0 if unknown.
      * @return ParseResult
      */
-    ParseResult process(SparkplugTopic &topic, tahu::Payload *payload);
+    ParseResult process(SparkplugTopic &topic, tahu::Payload *payload, PayloadReader *reader = nullptr, int64_t received = 0);
     /**
      * @brief Appends the Node's and Device's payloads if it they changes
      *
      * @param payloads
      * @param force
+     * @param subscribers Only appends Metrics that match one of these subscribers
+     */
+    void appendTo(std::vector<PublishableUpdate> &payloads, bool force = false, uint64_t subscribers = ALL_SUBSCRIBERS);
+    /**
+     * @brief Appends Payloads of the Node and its Devices changed after a model version, without acknowledging any changes
+     *
+     * @param payloads
+     * @param since The model version
+     * @param subscribers Only appends Metrics that match one of these subscribers
+     */
+    void appendSince(std::vector<PublishableUpdate> &payloads, uint64_t since, uint64_t subscribers = ALL_SUBSCRIBERS);
+    /**
+     * @brief Gets the latest model version of the Node, its Devices or any of their Metrics
+     *
+     * @return uint64_t
+     */
+    uint64_t getVersion();
+    /**
+     * @brief Catches the Node up with a model version of itself or one of its Devices
+     *
+     * @param version
+     */
+    void track(uint64_t version);
+    /**
+     * @brief Matches every Metric of the Node and its Devices against the Metric filters and deadbands
+     *
      */
-    void appendTo(std::vector<PublishableUpdate> &payloads, bool force = false);
+    void subscribe();
     /**
      * @brief Returns false as the Node is not a device
      *
@@ -72,6 +238,57 @@ public:
      * @return false
      */
     virtual bool isDevice() override;
+    /**
+     * @brief Restores the Node or one of its Devices from a snapshot.
+     * The restored values are kept until the Node's NBIRTH, messages received before it request a rebirth
+     * at most once every RESTORED_REBIRTH_INTERVAL_US instead of being applied.
+     *
+     * @param device The name of the Device, or empty for the Node
+     * @param payload
+     */
+    void restore(const std::string &device, tahu::Payload *payload);
+    /**
+     * @brief Finds a Device of the Node
+     *
+     * @param device The name of the Device, without the Node's name
+     * @return Device* The Device, or nullptr if the Node has no Device with the name
+     */
+    Device *findDevice(const std::string &device);
+    /**
+     * @brief Gets the latencies of the messages from the Node and its Devices
+     *
+     * @return LatencyTracker&
+     */
+    LatencyTracker &getLatency();
+    /**
+     * @brief Takes a message the Node reported as LIMITED, holding it until the rate limit allows
+     *
+     * @param topic
+     * @param payload
+     * @param source The encoded message, when only the header of the payload has been decoded
+     * @param received When the message was received in microseconds since the epoch, 0 if unknown
+     * @param reader The Metrics of the encoded message if they were already indexed
+     */
+    void defer(SparkplugTopic &topic, tahu::Payload *payload, mqtt::const_message_ptr source, int64_t received = 0, std::unique_ptr<PayloadReader> reader = nullptr);
+    /**
+     * @brief Applies the deferred messages the rate limit allows, called in turn for each Node with deferred messages.
+     * The Node waits for another turn if messages remain.
+     *
+     * @return ParseResult OUT_OF_SYNC if any of the messages requires a rebirth
+     */
+    ParseResult release();
+    /**
+     * @brief Gets the number of data messages received over the rate limit
+     *
+     * @return uint64_t
+     */
+    uint64_t getLimited();
+    /**
+     * @brief Adds the Node and its Devices to a snapshot, if the Node is alive
+     *
+     * @param writer
+     */
+    void snapshot(SnapshotWriter &writer);
     bool isDirty();
 };
 
@@ -32,154 +32,280 @@
 #include "Property.h"
 #include "PropertySet.h"
 #include <pb_decode.h>
+#include <deque>
+#include <shared_mutex>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
 
 using namespace std;
 
-void Property::appendTo(tahu::PropertySet *propertySet, bool force)
+static shared_mutex keysLock;
+static deque<string> keyNames;
+static unordered_map<string_view, uint32_t> keyIds;
+
+uint32_t PropertyKeys::intern(const char *name)
 {
-    if (!dirty && !force)
+    string_view view(name);
+
     {
-        return;
+        shared_lock<shared_mutex> guard(keysLock);
+        auto item = keyIds.find(view);
+        if (item != keyIds.end())
+        {
+            return item->second;
+        }
     }
 
-    if (!force)
+    unique_lock<shared_mutex> guard(keysLock);
+    auto item = keyIds.find(view);
+    if (item != keyIds.end())
     {
-        dirty = false;
+        return item->second;
     }
 
-    if (type == PROPERTY_DATA_TYPE_PROPERTYSET)
-    {
-        tahu::PropertySet nestedSet;
-        memset(&nestedSet, 0, sizeof(tahu::PropertySet));
+    // Names are never removed, so views of them stay valid as the deque grows
+    uint32_t key = keyNames.size();
+    keyNames.emplace_back(name);
+    keyIds.emplace(string_view(keyNames.back()), key);
+    return key;
+}
 
-        value.propertySetValue->appendTo(&nestedSet, force);
-        add_property_to_set(propertySet, name.c_str(), type, &nestedSet, 0);
+const string &PropertyKeys::name(uint32_t key)
+{
+    shared_lock<shared_mutex> guard(keysLock);
+    return keyNames[key];
+}
 
-        // We're allocating memory during appendTo, and the data is duplicated from
-        // the nestedSet to the propertySet. Because of this we must release the nestedSet
-        pb_release(org_eclipse_tahu_protobuf_Payload_PropertySet_fields, &nestedSet);
-    }
-    else
+/**
+ * @brief The size of a fixed width Property value
+ *
+ */
+static size_t lengthOf(uint32_t type)
+{
+    switch (type)
     {
-        if (type == PROPERTY_DATA_TYPE_TEXT || type == PROPERTY_DATA_TYPE_STRING)
-        {
-            add_property_to_set(propertySet, name.c_str(), type, value.stringValue, length);
-        }
-        else
-        {
-            add_property_to_set(propertySet, name.c_str(), type, &value, length);
-        }
+    case PROPERTY_DATA_TYPE_INT8:
+    case PROPERTY_DATA_TYPE_UINT8:
+        return sizeof(int8_t);
+    case PROPERTY_DATA_TYPE_INT16:
+    case PROPERTY_DATA_TYPE_UINT16:
+        return sizeof(int16_t);
+    case PROPERTY_DATA_TYPE_INT32:
+    case PROPERTY_DATA_TYPE_UINT32:
+        return sizeof(int32_t);
+    case PROPERTY_DATA_TYPE_INT64:
+    case PROPERTY_DATA_TYPE_UINT64:
+    case PROPERTY_DATA_TYPE_DATETIME:
+        return sizeof(int64_t);
+    case PROPERTY_DATA_TYPE_FLOAT:
+        return sizeof(float);
+    case PROPERTY_DATA_TYPE_DOUBLE:
+        return sizeof(double);
+    case PROPERTY_DATA_TYPE_BOOLEAN:
+        return sizeof(bool);
+    default:
+        return 0;
     }
 }
 
-inline void Property::clearValue()
+static inline bool isString(uint32_t type)
 {
-    switch (type)
+    return type == PROPERTY_DATA_TYPE_STRING || type == PROPERTY_DATA_TYPE_TEXT;
+}
+
+/**
+ * @brief FNV-1a hash of a block of memory
+ *
+ */
+static uint64_t hashOf(const void *data, size_t length, uint64_t hash = 0xcbf29ce484222325)
+{
+    const uint8_t *bytes = (const uint8_t *)data;
+    for (size_t i = 0; i < length; i++)
     {
-    case PROPERTY_DATA_TYPE_STRING:
-    case PROPERTY_DATA_TYPE_TEXT:
-        if (value.stringValue)
-        {
-            free(value.stringValue);
-        }
-        break;
-    case PROPERTY_DATA_TYPE_PROPERTYSET:
-        delete value.propertySetValue;
-        break;
-    default:
-        break;
+        hash = (hash ^ bytes[i]) * 0x100000001b3;
     }
-    memset(&value, 0, sizeof(PropertyValueUnion));
+    return hash;
 }
 
-ParseResult Property::process(tahu::Property *property)
+/**
+ * @brief Reads the raw bits of a fixed width value from a tahu Property
+ *
+ */
+static uint64_t bitsOf(uint32_t type, const void *value)
 {
-    if (property->type != type && type != PROPERTY_DATA_TYPE_UNKNOWN)
+    uint64_t bits = 0;
+    size_t length = lengthOf(type);
+
+    // Smaller integers are stored in the 32 bit member of the value unions
+    if (length > 0 && length < sizeof(uint32_t) && type != PROPERTY_DATA_TYPE_BOOLEAN)
     {
-        return ParseResult::OUT_OF_SYNC;
+        length = sizeof(uint32_t);
     }
 
-    dirty = true;
+    memcpy(&bits, value, length);
+    return bits;
+}
+
+bool Property::read(tahu::Property *property)
+{
+    type = property->type;
 
-    switch (property->type)
+    switch (type)
     {
     case PROPERTY_DATA_TYPE_INT8:
     case PROPERTY_DATA_TYPE_UINT8:
-        length = sizeof(int8_t);
-        value.intValue = property->value.int_value;
-        break;
     case PROPERTY_DATA_TYPE_INT16:
     case PROPERTY_DATA_TYPE_UINT16:
-        length = sizeof(int16_t);
-        value.intValue = property->value.int_value;
-        break;
     case PROPERTY_DATA_TYPE_INT32:
     case PROPERTY_DATA_TYPE_UINT32:
-        length = sizeof(int32_t);
         value.intValue = property->value.int_value;
-        break;
+        return true;
     case PROPERTY_DATA_TYPE_INT64:
     case PROPERTY_DATA_TYPE_UINT64:
     case PROPERTY_DATA_TYPE_DATETIME:
-        length = sizeof(int64_t);
         value.longValue = property->value.long_value;
-        break;
+        return true;
     case PROPERTY_DATA_TYPE_FLOAT:
-        length = sizeof(float);
         value.floatValue = property->value.float_value;
-        break;
+        return true;
     case PROPERTY_DATA_TYPE_DOUBLE:
-        length = sizeof(double);
         value.doubleValue = property->value.double_value;
-        break;
+        return true;
     case PROPERTY_DATA_TYPE_BOOLEAN:
-        length = sizeof(bool);
         value.booleanValue = property->value.boolean_value;
-        break;
+        return true;
     case PROPERTY_DATA_TYPE_STRING:
     case PROPERTY_DATA_TYPE_TEXT:
-        if (value.stringValue)
-        {
-            free(value.stringValue);
-        }
-        length = strlen(property->value.string_value) + 1;
-        value.stringValue = strdup(property->value.string_value);
-        break;
+        value.stringValue = strdup(property->value.string_value ? property->value.string_value : "");
+        return true;
     case PROPERTY_DATA_TYPE_PROPERTYSET:
-        if (!value.propertySetValue)
-        {
-            value.propertySetValue = new PropertySet();
-        }
-        value.propertySetValue->process(&property->value.propertyset_value);
-        length = sizeof(PropertySet);
-        break;
+        value.propertySetValue = new PropertyTable();
+        value.propertySetValue->read(&property->value.propertyset_value);
+        return true;
     default:
-        break;
+        return false;
     }
+}
 
-    type = property->type;
+bool Property::matches(const tahu::Property *property) const
+{
+    if (property->type != type)
+    {
+        return false;
+    }
 
-    return ParseResult::OK;
+    if (isString(type))
+    {
+        return strcmp(value.stringValue, property->value.string_value ? property->value.string_value : "") == 0;
+    }
+
+    if (type == PROPERTY_DATA_TYPE_PROPERTYSET)
+    {
+        return value.propertySetValue->matches(&property->value.propertyset_value);
+    }
+
+    return bitsOf(type, &value) == bitsOf(type, &property->value);
 }
 
-bool Property::isDirty()
+Property Property::copy() const
 {
-    return dirty;
+    Property duplicate = *this;
+
+    if (isString(type))
+    {
+        duplicate.value.stringValue = strdup(value.stringValue);
+    }
+    else if (type == PROPERTY_DATA_TYPE_PROPERTYSET)
+    {
+        duplicate.value.propertySetValue = new PropertyTable(*value.propertySetValue);
+    }
+
+    return duplicate;
 }
 
 void Property::clear()
 {
-    clearValue();
+    if (isString(type))
+    {
+        free(value.stringValue);
+    }
+    else if (type == PROPERTY_DATA_TYPE_PROPERTYSET)
+    {
+        delete value.propertySetValue;
+    }
+
+    memset(&value, 0, sizeof(PropertyValueUnion));
     type = PROPERTY_DATA_TYPE_UNKNOWN;
 }
 
-Property::Property(string &name)
+bool Property::equals(const Property &other) const
 {
-    clearValue();
-    this->name = string(name);
+    if (key != other.key || type != other.type)
+    {
+        return false;
+    }
+
+    if (isString(type))
+    {
+        return strcmp(value.stringValue, other.value.stringValue) == 0;
+    }
+
+    if (type == PROPERTY_DATA_TYPE_PROPERTYSET)
+    {
+        return value.propertySetValue->equals(*other.value.propertySetValue);
+    }
+
+    return bitsOf(type, &value) == bitsOf(type, &other.value);
+}
+
+uint64_t Property::hash() const
+{
+    uint64_t hash = hashOf(&key, sizeof(key));
+    hash = hashOf(&type, sizeof(type), hash);
+
+    if (isString(type))
+    {
+        return hashOf(value.stringValue, strlen(value.stringValue), hash);
+    }
+
+    if (type == PROPERTY_DATA_TYPE_PROPERTYSET)
+    {
+        uint64_t nested = value.propertySetValue->hash();
+        return hashOf(&nested, sizeof(nested), hash);
+    }
+
+    uint64_t bits = bitsOf(type, &value);
+    return hashOf(&bits, sizeof(bits), hash);
+}
+
+void Property::appendTo(tahu::PropertySet *propertySet) const
+{
+    const char *name = getName().c_str();
+
+    if (type == PROPERTY_DATA_TYPE_PROPERTYSET)
+    {
+        tahu::PropertySet nestedSet;
+        memset(&nestedSet, 0, sizeof(tahu::PropertySet));
+
+        value.propertySetValue->appendTo(&nestedSet);
+        add_property_to_set(propertySet, name, type, &nestedSet, 0);
+
+        // We're allocating memory during appendTo, and the data is duplicated from
+        // the nestedSet to the propertySet. Because of this we must release the nestedSet
+        pb_release(org_eclipse_tahu_protobuf_Payload_PropertySet_fields, &nestedSet);
+    }
+    else if (isString(type))
+    {
+        add_property_to_set(propertySet, name, type, value.stringValue, strlen(value.stringValue) + 1);
+    }
+    else
+    {
+        add_property_to_set(propertySet, name, type, &value, lengthOf(type));
+    }
 }
 
-Property::~Property()
+const string &Property::getName() const
 {
-    clear();
+    return PropertyKeys::name(key);
 }
@@ -36,19 +36,43 @@
 #include "CommonTypes.h"
 #include <string>
 
-class PropertySet;
+class PropertyTable;
 
 /**
- * @brief A class that represents a Sparkplug Property
+ * @brief Interns Property names so each Property only stores a small id.
+ * Names are shared by every Property Set, and are kept for the lifetime of the process.
+ *
+ */
+class PropertyKeys
+{
+public:
+    /**
+     * @brief Gets the id of a name, assigning a new id if it has none
+     *
+     * @param name
+     * @return uint32_t
+     */
+    static uint32_t intern(const char *name);
+    /**
+     * @brief Gets the name of an id
+     *
+     * @param key
+     * @return const std::string&
+     */
+    static const std::string &name(uint32_t key);
+};
+
+/**
+ * @brief A class that represents a Sparkplug Property.
+ * Properties are trivially copyable so they can be stored inline, the PropertyTable holding a Property
+ * owns any memory allocated for its value.
  *
  */
 class Property
 {
-private:
-    size_t length;
+public:
+    uint32_t key = 0;
     uint32_t type = PROPERTY_DATA_TYPE_UNKNOWN;
-    bool dirty;
-    std::string name;
 
     union PropertyValueUnion
     {
@@ -58,45 +82,45 @@ private:
         double doubleValue;
         bool booleanValue;
         char *stringValue;
-        PropertySet *propertySetValue;
-    } value;
+        PropertyTable *propertySetValue;
+    } value = {};
 
     /**
-     * @brief Clears the value on the Property
-     * Frees any allocated memory
+     * @brief Reads the value of a tahu Property, allocating memory for strings and nested Property Sets
+     *
+     * @param property
+     * @return true
+     * @return false The datatype isn't supported
      */
-    inline void clearValue();
-
-protected:
-public:
-    Property(std::string &name);
-    ~Property();
+    bool read(tahu::Property *property);
     /**
-     * @brief Clears the data associated with this Property
+     * @brief Whether a tahu Property has the same datatype and value as this Property
      *
+     * @param property
+     * @return true
+     * @return false
      */
-    void clear();
+    bool matches(const tahu::Property *property) const;
     /**
-     * @brief Appends this property to a Property Set if it has had changes
+     * @brief Copies the Property, duplicating any allocated memory
      *
-     * @param propertySet
-     * @param force Forces the Property to be appended
+     * @return Property
      */
-    void appendTo(tahu::PropertySet *propertySet, bool force = false);
+    Property copy() const;
     /**
-     * @brief Processes a tahu Property and updates the Property
+     * @brief Frees any allocated memory
      *
-     * @param property
-     * @return ParseResult
      */
-    ParseResult process(tahu::Property *property);
+    void clear();
+    bool equals(const Property &other) const;
+    uint64_t hash() const;
     /**
-     * @brief Whether the property has data that hasn't been acknowledged
+     * @brief Appends this Property to a Property Set
      *
-     * @return true
-     * @return false
+     * @param propertySet
      */
-    bool isDirty();
+    void appendTo(tahu::PropertySet *propertySet) const;
+    const std::string &getName() const;
 };
 
 #endif /* SRC_TYPES_PROPERTY */
@@ -30,56 +30,298 @@
  */
 
 #include "PropertySet.h"
+#include <mutex>
+#include <unordered_map>
+#include <utility>
 
-void PropertySet::appendTo(tahu::Metric *metric, bool force)
+using namespace std;
+
+/**
+ * @brief Tables in use, by hash. Expired entries are removed as they are found, and swept once the pool doubles.
+ *
+ */
+static mutex poolLock;
+static unordered_multimap<uint64_t, weak_ptr<const PropertyTable>> pool;
+static size_t sweepAt = 1024;
+
+PropertyTable::PropertyTable(const PropertyTable &other)
 {
-    if (size() == 0)
+    for (const Property &property : other.properties)
     {
-        return;
+        properties.push_back(property.copy());
     }
+}
 
-    bool hasChanges = force || any([](Property *property)
-                                   { return property->isDirty(); });
+PropertyTable::~PropertyTable()
+{
+    for (Property &property : properties)
+    {
+        property.clear();
+    }
+}
 
-    if (!hasChanges)
+void PropertyTable::read(tahu::PropertySet *propertySet)
+{
+    for (size_t i = 0; i < propertySet->keys_count && i < propertySet->values_count; i++)
+    {
+        Property property;
+        property.key = PropertyKeys::intern(propertySet->keys[i]);
+        if (property.read(&propertySet->values[i]))
+        {
+            properties.push_back(property);
+        }
+    }
+}
+
+bool PropertyTable::matches(const tahu::PropertySet *propertySet) const
+{
+    if (propertySet->keys_count != properties.size())
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < properties.size(); i++)
+    {
+        if (properties[i].getName().compare(propertySet->keys[i]) != 0 ||
+            !properties[i].matches(&propertySet->values[i]))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int PropertyTable::indexOf(uint32_t key) const
+{
+    for (size_t i = 0; i < properties.size(); i++)
+    {
+        if (properties[i].key == key)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void PropertyTable::add(Property property)
+{
+    properties.push_back(property);
+}
+
+void PropertyTable::replace(size_t index, Property property)
+{
+    properties[index].clear();
+    properties[index] = property;
+}
+
+size_t PropertyTable::size() const
+{
+    return properties.size();
+}
+
+const Property &PropertyTable::operator[](size_t index) const
+{
+    return properties[index];
+}
+
+bool PropertyTable::equals(const PropertyTable &other) const
+{
+    if (properties.size() != other.properties.size())
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < properties.size(); i++)
+    {
+        if (!properties[i].equals(other.properties[i]))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+uint64_t PropertyTable::hash() const
+{
+    uint64_t hash = properties.size();
+    for (const Property &property : properties)
+    {
+        hash = (hash ^ property.hash()) * 0x100000001b3;
+    }
+    return hash;
+}
+
+void PropertyTable::appendTo(tahu::PropertySet *propertySet) const
+{
+    for (const Property &property : properties)
+    {
+        property.appendTo(propertySet);
+    }
+}
+
+shared_ptr<const PropertyTable> PropertyTable::share(PropertyTable *table)
+{
+    uint64_t digest = table->hash();
+    lock_guard<mutex> guard(poolLock);
+
+    auto range = pool.equal_range(digest);
+    for (auto item = range.first; item != range.second;)
+    {
+        auto existing = item->second.lock();
+        if (!existing)
+        {
+            item = pool.erase(item);
+            continue;
+        }
+
+        if (existing->equals(*table))
+        {
+            delete table;
+            return existing;
+        }
+        item++;
+    }
+
+    if (pool.size() >= sweepAt)
+    {
+        erase_if(pool, [](const pair<const uint64_t, weak_ptr<const PropertyTable>> &item)
+                 { return item.second.expired(); });
+        sweepAt = max<size_t>(1024, pool.size() * 2);
+    }
+
+    shared_ptr<const PropertyTable> shared(table);
+    pool.emplace(digest, shared);
+    return shared;
+}
+
+void PropertySet::appendTo(tahu::Metric *metric, bool force)
+{
+    if (size() == 0 || (!force && !dirty))
     {
         return;
     }
 
     metric->has_properties = true;
-    each([&metric, force](Property *property)
-         { property->appendTo(&metric->properties, force); });
+    appendTo(&metric->properties, force);
 }
 
 void PropertySet::appendTo(tahu::PropertySet *propertySet, bool force)
 {
-    if (size() == 0)
+    if (!table)
     {
         return;
     }
 
-    bool hasChanges = force || any([](Property *property)
-                                   { return property->isDirty(); });
-
-    if (!hasChanges)
+    for (size_t i = 0; i < table->size(); i++)
     {
-        return;
+        if (force || (dirty & bitOf(i)))
+        {
+            (*table)[i].appendTo(propertySet);
+        }
     }
 
-    each([&propertySet, force](Property *property)
-         { property->appendTo(propertySet, force); });
+    if (!force)
+    {
+        dirty = 0;
+    }
 }
 
-ParseResult PropertySet::process(tahu::PropertySet *propertySet)
+ParseResult PropertySet::process(tahu::PropertySet *propertySet, int skip)
 {
-    for (size_t i = 0; i < propertySet->keys_count; i++)
+    // Copied from the shared table on the first changed property
+    PropertyTable *updated = nullptr;
+
+    for (size_t i = 0; i < propertySet->keys_count && i < propertySet->values_count; i++)
     {
-        const char *key = propertySet->keys[i];
-        auto property = get(key);
-        if (property->process(&propertySet->values[i]) == ParseResult::OUT_OF_SYNC)
+        if ((int)i == skip)
+        {
+            continue;
+        }
+
+        tahu::Property *source = &propertySet->values[i];
+        const PropertyTable *current = updated ? updated : table.get();
+        uint32_t key = PropertyKeys::intern(propertySet->keys[i]);
+        int index = current ? current->indexOf(key) : -1;
+
+        if (index >= 0)
+        {
+            const Property &property = (*current)[index];
+
+            if (property.type != source->type)
+            {
+                delete updated;
+                return ParseResult::OUT_OF_SYNC;
+            }
+
+            if (property.matches(source))
+            {
+                continue;
+            }
+        }
+
+        Property property;
+        property.key = key;
+        if (!property.read(source))
+        {
+            continue;
+        }
+
+        if (!updated)
         {
-            return ParseResult::OUT_OF_SYNC;
-        };
+            updated = table ? new PropertyTable(*table) : new PropertyTable();
+        }
+
+        if (index >= 0)
+        {
+            updated->replace(index, property);
+        }
+        else
+        {
+            index = updated->size();
+            updated->add(property);
+        }
+
+        dirty |= bitOf(index);
     }
+
+    if (updated)
+    {
+        table = PropertyTable::share(updated);
+    }
+
     return ParseResult::OK;
 }
+
+bool PropertySet::isDirty() const
+{
+    return dirty != 0;
+}
+
+const Property *PropertySet::find(const char *name) const
+{
+    if (!table)
+    {
+        return nullptr;
+    }
+
+    int index = table->indexOf(PropertyKeys::intern(name));
+    return index >= 0 ? &(*table)[index] : nullptr;
+}
+
+const PropertyTable *PropertySet::getTable() const
+{
+    return table.get();
+}
+
+size_t PropertySet::size() const
+{
+    return table ? table->size() : 0;
+}
+
+void PropertySet::clear()
+{
+    table.reset();
+    dirty = 0;
+}
@@ -34,39 +34,152 @@
 
 #include "TahuTypes.h"
 #include "Property.h"
-#include "../DataCollection.h"
 #include "CommonTypes.h"
+#include "../utilities/SmallVector.h"
+#include <memory>
+
+#define PROPERTY_INLINE_CAPACITY 4
+
+/**
+ * @brief An ordered list of Properties stored inline for small sets.
+ * Tables are immutable once shared, identical tables are shared between Property Sets.
+ *
+ */
+class PropertyTable
+{
+private:
+    SmallVector<Property, PROPERTY_INLINE_CAPACITY> properties;
+
+protected:
+public:
+    PropertyTable() = default;
+    PropertyTable(const PropertyTable &other);
+    PropertyTable &operator=(const PropertyTable &) = delete;
+    ~PropertyTable();
+    /**
+     * @brief Reads all properties of a tahu::PropertySet
+     *
+     * @param propertySet
+     */
+    void read(tahu::PropertySet *propertySet);
+    /**
+     * @brief Whether a tahu::PropertySet has the same properties in the same order as this table
+     *
+     * @param propertySet
+     * @return true
+     * @return false
+     */
+    bool matches(const tahu::PropertySet *propertySet) const;
+    /**
+     * @brief Finds the index of a property
+     *
+     * @param key The interned name of the property
+     * @return int The index, or -1 if the table has no property with the name
+     */
+    int indexOf(uint32_t key) const;
+    /**
+     * @brief Adds a property, taking ownership of its memory
+     *
+     * @param property
+     */
+    void add(Property property);
+    /**
+     * @brief Replaces a property, taking ownership of its memory
+     *
+     * @param index
+     * @param property
+     */
+    void replace(size_t index, Property property);
+    size_t size() const;
+    const Property &operator[](size_t index) const;
+    bool equals(const PropertyTable &other) const;
+    uint64_t hash() const;
+    /**
+     * @brief Appends every property to a Property Set
+     *
+     * @param propertySet
+     */
+    void appendTo(tahu::PropertySet *propertySet) const;
+    /**
+     * @brief Shares a table, replacing it with an identical table already in use if there is one
+     *
+     * @param table The table to share, ownership is taken
+     * @return std::shared_ptr<const PropertyTable>
+     */
+    static std::shared_ptr<const PropertyTable> share(PropertyTable *table);
+};
 
 /**
- * @brief A class that represents a Sparkplug Property Set
+ * @brief A class that represents a Sparkplug Property Set.
+ * The properties are held in a shared immutable table, a Property Set only tracks which properties changed.
+ * Updates copy the table before changing it.
  *
  */
-class PropertySet : public DataCollection<Property>
+class PropertySet
 {
 private:
+    std::shared_ptr<const PropertyTable> table;
+    /**
+     * @brief A bit for each changed property, properties past the 64th share the last bit
+     *
+     */
+    uint64_t dirty = 0;
+
+    static inline uint64_t bitOf(size_t index)
+    {
+        return (uint64_t)1 << (index < 63 ? index : 63);
+    }
+
 protected:
 public:
     /**
      * @brief Appends the Property Set to the Metric
-     *code
+     *
      * @param metric
      * @param force Forces all properties to be appended
      */
     void appendTo(tahu::Metric *metric, bool force = false);
     /**
-     * @brief Appends all properties in this Property Set to a Property Set
+     * @brief Appends the properties in this Property Set to a Property Set
      *
      * @param propertySet
-     * @param force Forces all properties to be appended
+     * @param force Forces all properties to be appended, otherwise only the changed properties are
      */
     void appendTo(tahu::PropertySet *propertySet, bool force = false);
     /**
-     * @brief Processes a tahu::PropertySet processing all properties
+     * @brief Processes a tahu::PropertySet, only properties with new values are flagged as changed
      *
      * @param propertySet
-     * @return ParseResult
+     * @param skip The index of a property that is stored elsewhere, or -1
+     * @return ParseResult OUT_OF_SYNC if the datatype of a property changed
+     */
+    ParseResult process(tahu::PropertySet *propertySet, int skip = -1);
+    /**
+     * @brief Whether any properties changed since they were last appended
+     *
+     * @return true
+     * @return false
+     */
+    bool isDirty() const;
+    /**
+     * @brief Finds a property by name
+     *
+     * @param name
+     * @return const Property* The property, or nullptr if the set has no property with the name
+     */
+    const Property *find(const char *name) const;
+    size_t size() const;
+    /**
+     * @brief Gets the shared table holding the properties, which is replaced whenever a property changes
+     *
+     * @return const PropertyTable* The table, or nullptr if the set has no properties
+     */
+    const PropertyTable *getTable() const;
+    /**
+     * @brief Removes all properties
+     *
      */
-    ParseResult process(tahu::PropertySet *propertySet);
+    void clear();
 };
 
 #endif /* SRC_TYPES_PROPERTYSET */
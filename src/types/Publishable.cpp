@@ -31,6 +31,7 @@
 
 #include "Publishable.h"
 #include "pb_decode.h"
+#include <algorithm>
 
 #define DEBUGGING 1
 #ifdef DEBUGGING
@@ -43,12 +44,32 @@
 
 using namespace std;
 
-ParseResult Publishable::process(SparkplugTopic &topic, tahu::Payload *payload)
+/**
+ * @brief Whether a birthed Metric is a Template definition rather than a value
+ *
+ */
+static inline bool isDefinition(tahu::Metric *metric)
+{
+    return metric->datatype == METRIC_DATA_TYPE_TEMPLATE &&
+           metric->which_value == org_eclipse_tahu_protobuf_Payload_Metric_template_value_tag &&
+           metric->value.template_value.has_is_definition &&
+           metric->value.template_value.is_definition;
+}
+
+ParseResult Publishable::process(SparkplugTopic &topic, tahu::Payload *payload, PayloadReader *reader)
 {
-    if (topic.isDeath() && state == PublishableState::ACTIVE)
+    synchronize();
+
+    // A death ends the session in any live state, births that were never read through getPayloads included
+    if (topic.isDeath() && isAlive())
     {
         stale();
         changedState = ChangedState::CHANGES;
+        stamp();
+        if (context)
+        {
+            context->timeouts.cancel(&timeout);
+        }
         return ParseResult::OK;
     }
 
@@ -81,8 +102,22 @@ ParseResult Publishable::process(SparkplugTopic &topic, tahu::Payload *payload)
                 return ParseResult::OK;
             }
         }
-        lastValidMessage = payload->timestamp;
-        loadPayload(payload);
+        // Coalesced messages are processed newest first
+        if (!coalesced || (time_t)payload->timestamp > lastValidMessage)
+        {
+            lastValidMessage = payload->timestamp;
+        }
+        uint64_t before = context ? context->version : 0;
+        if (reader)
+        {
+            loadPayload(*reader);
+        }
+        else
+        {
+            loadPayload(payload);
+        }
+        advance(before);
+        refresh();
         return ParseResult::OK;
     }
 
@@ -92,7 +127,10 @@ ParseResult Publishable::process(SparkplugTopic &topic, tahu::Payload *payload)
         changedState = ChangedState::CHANGES;
         birthed();
         lastValidMessage = payload->timestamp;
+        stamp();
         loadPayload(payload, true);
+        advance(stateVersion);
+        refresh();
         return ParseResult::OK;
     }
 
@@ -104,36 +142,371 @@ ParseResult Publishable::process(SparkplugTopic &topic, tahu::Payload *payload)
     return ParseResult::OK;
 }
 
+void Publishable::restore(tahu::Payload *payload)
+{
+    stamp();
+    loadPayload(payload, true);
+    advance(stateVersion);
+    setState(PublishableState::RESTORED);
+    actionState = ActionState::NOTHING;
+    changedState = ChangedState::CHANGES;
+    lastValidMessage = payload->timestamp;
+    refresh();
+}
+
+tahu::Payload *Publishable::snapshot()
+{
+    synchronize();
+
+    if (!isAlive())
+    {
+        return nullptr;
+    }
+
+    tahu::Payload *payload = createPayload();
+
+    // Definitions are birthed before the instances that reference them
+    if (scope.templates && !isDevice())
+    {
+        scope.templates->appendTo(payload);
+    }
+
+    each([payload](Metric *metric)
+         { metric->snapshot(payload); });
+
+    return payload;
+}
+
+tahu::Payload *Publishable::createPayload()
+{
+    tahu::Payload *payload = (org_eclipse_tahu_protobuf_Payload *)malloc(sizeof(org_eclipse_tahu_protobuf_Payload));
+
+    // Initialize payload
+    memset(payload, 0, sizeof(org_eclipse_tahu_protobuf_Payload));
+
+    payload->has_seq = false;
+    payload->has_timestamp = true;
+    payload->timestamp = lastValidMessage;
+
+    return payload;
+}
+
+void Publishable::stamp()
+{
+    if (context)
+    {
+        stateVersion = version = ++context->version;
+    }
+
+    // Devices alive in the ending session are no longer counted as online
+    if (statistics && session.online != 0)
+    {
+        statistics->add(&ModelStatistics::onlineDevices, -session.online);
+    }
+    session.online = 0;
+    session.epoch++;
+    session.version = stateVersion;
+
+    if (parent)
+    {
+        epoch = parent->epoch;
+    }
+}
+
+void Publishable::synchronize()
+{
+    if (!parent || epoch == parent->epoch)
+    {
+        return;
+    }
+
+    epoch = parent->epoch;
+
+    if (state == PublishableState::STALE)
+    {
+        return;
+    }
+
+    // The Device stopped being counted as online when the session ended
+    state = PublishableState::STALE;
+    changedState = ChangedState::CHANGES;
+    stateVersion = parent->version;
+    version = std::max(version, stateVersion);
+    session.epoch++;
+    session.version = stateVersion;
+
+    if (context)
+    {
+        context->timeouts.cancel(&timeout);
+    }
+}
+
+void Publishable::joinSession(PublisherSession *parent)
+{
+    this->parent = parent;
+    epoch = parent->epoch;
+}
+
+void Publishable::advance(uint64_t before)
+{
+    // Metrics advance the model version as they change
+    if (context && context->version != before)
+    {
+        version = context->version;
+    }
+}
+
+uint64_t Publishable::getVersion()
+{
+    return version;
+}
+
+void Publishable::appendSince(std::vector<PublishableUpdate> &payloads, uint64_t since, uint64_t subscribers)
+{
+    synchronize();
+
+    if (version <= since)
+    {
+        return;
+    }
+
+    bool reborn = stateVersion > since;
+
+    if (reborn && state == PublishableState::STALE)
+    {
+        payloads.push_back(PublishableUpdate(nullptr, name, UpdateType::DEATH));
+        return;
+    }
+
+    tahu::Payload *payload = createPayload();
+
+    // Consumers that missed a birth receive every Metric, otherwise only the Metrics changed since their version
+    each([payload, reborn, since, subscribers](Metric *metric)
+         {
+            if (!reborn)
+            {
+                metric->appendSince(payload, since, subscribers);
+            }
+            else if (metric->isSubscribed(subscribers))
+            {
+                metric->snapshot(payload);
+            } });
+
+    if (!reborn && payload->metrics_count == 0)
+    {
+        free_payload(payload);
+        free(payload);
+        return;
+    }
+
+    if (!reborn)
+    {
+        payloads.push_back(PublishableUpdate(payload, name, UpdateType::PUBLISH));
+        return;
+    }
+
+    PublishableUpdate update(payload, name, state == PublishableState::RESTORED ? UpdateType::RESTORED : UpdateType::BIRTH);
+    update.diff = diff;
+    payloads.push_back(update);
+}
+
+void Publishable::useTemplates(TemplateLibrary *templates)
+{
+    scope.templates = templates;
+}
+
+void Publishable::usePool(ObjectPool<Metric> *pool)
+{
+    factory = [pool](std::string &name)
+    { return pool->create(name); };
+    destroy = [this, pool](Metric *metric)
+    {
+        if (context)
+        {
+            context->handles.release(metric);
+        }
+        pool->destroy(metric);
+    };
+}
+
+bool Publishable::isAlive()
+{
+    return state != PublishableState::STALE;
+}
+
 bool Publishable::hasMetric(tahu::Metric &input)
 {
     return false;
 }
 
+bool Publishable::isCounted()
+{
+    return state != PublishableState::STALE && (!parent || epoch == parent->epoch);
+}
+
+void Publishable::setState(PublishableState next)
+{
+    bool wasCounted = isCounted();
+    state = next;
+    bool counted = isCounted();
+
+    if (wasCounted == counted)
+    {
+        return;
+    }
+
+    if (statistics)
+    {
+        if (parent)
+        {
+            parent->online += counted ? 1 : -1;
+        }
+        statistics->add(isDevice() ? &ModelStatistics::onlineDevices : &ModelStatistics::onlineNodes, counted ? 1 : -1);
+    }
+}
+
+void Publishable::useStatistics(ModelStatistics *statistics)
+{
+    auto total = isDevice() ? &ModelStatistics::devices : &ModelStatistics::nodes;
+    auto online = isDevice() ? &ModelStatistics::onlineDevices : &ModelStatistics::onlineNodes;
+
+    bool counted = isCounted();
+
+    if (this->statistics)
+    {
+        this->statistics->add(total, -1);
+        if (counted)
+        {
+            this->statistics->add(online, -1);
+        }
+    }
+
+    // The Node's session only tracks the Devices counted in statistics
+    if (parent && counted)
+    {
+        parent->online += (statistics != nullptr) - (this->statistics != nullptr);
+    }
+
+    this->statistics = statistics;
+
+    if (statistics)
+    {
+        statistics->add(total, 1);
+        if (counted)
+        {
+            statistics->add(online, 1);
+        }
+    }
+}
+
+void Publishable::coalesce(std::unordered_set<const Metric *> *applied)
+{
+    coalesced = applied;
+}
+
+ModelStatistics *Publishable::getStatistics()
+{
+    return statistics;
+}
+
+bool Publishable::isStale()
+{
+    synchronize();
+    return state == PublishableState::STALE || state == PublishableState::RESTORED;
+}
+
 void Publishable::stale()
 {
-    state = PublishableState::STALE;
+    setState(PublishableState::STALE);
 }
 
 void Publishable::birthed()
 {
-    state = PublishableState::BIRTHED;
+    setState(PublishableState::BIRTHED);
 }
 
 void Publishable::active()
 {
-    state = PublishableState::ACTIVE;
+    setState(PublishableState::ACTIVE);
+}
+
+void Publishable::refresh()
+{
+    if (!context || !isAlive())
+    {
+        return;
+    }
+
+    if (timeoutRevision != context->timeoutRevision)
+    {
+        auto match = context->publisherTimeouts.find(name);
+        timeoutTicks = match != context->publisherTimeouts.end() ? match->second : context->defaultTimeout;
+        timeoutRevision = context->timeoutRevision;
+    }
+
+    if (timeoutTicks == 0)
+    {
+        context->timeouts.cancel(&timeout);
+        return;
+    }
+
+    context->timeouts.schedule(&timeout, timeoutTicks);
+}
+
+void Publishable::expire()
+{
+    synchronize();
+
+    if (!isAlive())
+    {
+        return;
+    }
+
+    LOGGER("%s timed out\n", name.c_str());
+    stale();
+    changedState = ChangedState::CHANGES;
+    stamp();
+}
+
+std::string &Publishable::getName()
+{
+    return name;
+}
+
+std::shared_ptr<const BirthDiff> Publishable::getBirthDiff()
+{
+    return diff;
 }
 
 Publishable::Publishable(std::string name) : name(name)
 {
 }
 
+Publishable::Publishable(std::string name, ModelContext *context) : name(name), context(context)
+{
+    scope.bytes = &context->bytes;
+    scope.arrayDeltas = &context->arrayDeltas;
+    scope.version = &context->version;
+    scope.evicted = [this](Metric *metric)
+    {
+        version = ++this->context->version;
+        metric->evict(version);
+        this->context->evicted.push_back(this);
+    };
+}
+
 Publishable::~Publishable()
 {
+    if (context)
+    {
+        context->timeouts.cancel(&timeout);
+    }
 }
 
-void Publishable::appendTo(std::vector<PublishableUpdate> &payloads, bool force)
+void Publishable::appendTo(std::vector<PublishableUpdate> &payloads, bool force, uint64_t subscribers)
 {
+    synchronize();
+
     if ((changedState == ChangedState::CHANGES || force) && state == PublishableState::STALE)
     {
         if (!force)
@@ -144,35 +517,36 @@ void Publishable::appendTo(std::vector<PublishableUpdate> &payloads, bool force)
         return;
     }
 
+    bool restored = state == PublishableState::RESTORED && changedState == ChangedState::CHANGES;
     changedState = ChangedState::NOTHING;
 
-    bool hasChanges = force || any([](Metric *metric)
-                                   { return metric->isDirty(); });
+    bool hasChanges = (force && subscribers == ALL_SUBSCRIBERS) ||
+                      any([force, subscribers](Metric *metric)
+                          { return (force || metric->isDirty()) && metric->isSubscribed(subscribers); });
 
     if (!hasChanges)
     {
         return;
     }
 
-    tahu::Payload *payload = (org_eclipse_tahu_protobuf_Payload *)malloc(sizeof(org_eclipse_tahu_protobuf_Payload));
-
-    // Initialize payload
-    memset(payload, 0, sizeof(org_eclipse_tahu_protobuf_Payload));
-
-    payload->has_seq = false;
-    payload->has_timestamp = true;
-    payload->timestamp = lastValidMessage;
+    tahu::Payload *payload = createPayload();
 
-    each([payload, force](Metric *metric)
-         { metric->appendTo(payload, force); });
+    each([payload, force, subscribers](Metric *metric)
+         { metric->appendTo(payload, force, subscribers); });
 
     if (state == PublishableState::BIRTHED || force)
     {
+        PublishableUpdate update(payload, name, UpdateType::BIRTH);
         if (state == PublishableState::BIRTHED)
         {
+            update.diff = diff;
             active();
         }
-        payloads.push_back(PublishableUpdate(payload, name, UpdateType::BIRTH));
+        payloads.push_back(update);
+    }
+    else if (restored)
+    {
+        payloads.push_back(PublishableUpdate(payload, name, UpdateType::RESTORED));
     }
     else
     {
@@ -182,18 +556,189 @@ void Publishable::appendTo(std::vector<PublishableUpdate> &payloads, bool force)
 
 ParseResult Publishable::loadPayload(tahu::Payload *payload, bool isBirth)
 {
+    ParseResult result = ParseResult::OK;
+
     if (isBirth)
     {
-        clear();
+        aliases.clear();
+        diff = make_shared<BirthDiff>();
+        diff->initial = size() == 0;
     }
 
-    for (size_t i = 0; i < payload->metrics_count; i++)
+    // Births continue past a Metric that fails, so every Metric they name is reborn before the others are pruned
+    for (size_t i = 0; i < payload->metrics_count && (isBirth || result == ParseResult::OK); i++)
     {
         tahu::Metric *metric = &payload->metrics[i];
-        if (get(metric->name)->process(metric) == ParseResult::OUT_OF_SYNC)
+        Metric *target;
+
+        if (isBirth && isDefinition(metric))
+        {
+            // Definitions are shared by all instances instead of being tracked as Metrics
+            if (scope.templates && metric->name)
+            {
+                scope.templates->define(metric->name, &metric->value.template_value);
+            }
+            continue;
+        }
+
+        if (isBirth)
+        {
+            if (!metric->name)
+            {
+                continue;
+            }
+
+            // Metrics are kept between births, so rebirths only allocate the Metrics that are new
+            target = find(metric->name);
+            if (!target)
+            {
+                target = get(metric->name);
+                if (!diff->initial)
+                {
+                    diff->added.push_back(metric->name);
+                }
+            }
+
+            if (target->rebirth(metric->has_datatype ? metric->datatype : target->getType()))
+            {
+                diff->retyped.push_back(metric->name);
+            }
+
+            if (metric->has_alias)
+            {
+                aliases[metric->alias] = target;
+                target->setAlias(metric->alias);
+            }
+        }
+        else
         {
-            return ParseResult::OUT_OF_SYNC;
-        };
+            target = findMetric(metric->name, metric->has_alias, metric->alias);
+            if (!target || (coalesced && !coalesced->insert(target).second))
+            {
+                continue;
+            }
+        }
+
+        if (!isBirth && !target->isSubscribed())
+        {
+            continue;
+        }
+
+        int32_t quality = target->getQuality();
+
+        ParseResult processed = target->process(metric, &scope);
+        if (result == ParseResult::OK)
+        {
+            result = processed;
+        }
+
+        reportQuality(target, quality);
     }
-    return ParseResult::OK;
+
+    if (isBirth)
+    {
+        // Metrics left out of the birth no longer exist
+        remove([this](Metric *metric)
+               {
+                    if (metric->wasReborn())
+                    {
+                        return false;
+                    }
+                    diff->removed.push_back(metric->getName());
+                    return true; });
+        subscribe(true);
+    }
+
+    return result == ParseResult::OUT_OF_SYNC ? ParseResult::OUT_OF_SYNC : ParseResult::OK;
+}
+
+ParseResult Publishable::loadPayload(PayloadReader &reader)
+{
+    Metric *target = nullptr;
+    ParseResult result = ParseResult::OK;
+
+    bool valid = reader.each(
+        [this, &target](MetricHeader &header)
+        {
+            target = findMetric(header.name.empty() ? nullptr : header.name.c_str(), header.hasAlias, header.alias);
+            if (target && coalesced && !coalesced->insert(target).second)
+            {
+                return false;
+            }
+            return target != nullptr && target->isSubscribed() && !target->unchanged(header);
+        },
+        [this, &target, &result](tahu::Metric *metric, MetricHeader &header)
+        {
+            int32_t quality = target->getQuality();
+
+            if (target->process(metric, header, &scope) == ParseResult::OUT_OF_SYNC)
+            {
+                result = ParseResult::OUT_OF_SYNC;
+                return false;
+            }
+
+            reportQuality(target, quality);
+            return true;
+        });
+
+    if (!valid)
+    {
+        LOGGER("Failed to read an encoded payload for %s.\n", name.c_str());
+    }
+
+    return result;
+}
+
+void Publishable::subscribe(bool current)
+{
+    if (!context)
+    {
+        return;
+    }
+
+    bool watching = !context->qualityWatches.empty();
+
+    each([this, watching, current](Metric *metric)
+         {
+            // Data for Metrics outside every filter was skipped, so their last value may be hours old
+            if (metric->subscribe(context->filters.match(name, isDevice(), metric->getName(), metric->getType())) && !current)
+            {
+                metric->invalidate();
+            }
+            metric->setDeadband(context->deadbands.match(name, isDevice(), metric->getName(), metric->getType()));
+            metric->watchQuality(watching && context->qualityWatches.match(name, isDevice(), metric->getName(), metric->getType()) != 0); });
+}
+
+void Publishable::reportQuality(Metric *metric, int32_t previous)
+{
+    if (!context || !metric->isQualityWatched() || metric->getQuality() == previous)
+    {
+        return;
+    }
+
+    if (context->qualityChanges.size() >= MAX_QUALITY_CHANGES)
+    {
+        context->qualityChanges.pop_front();
+    }
+
+    context->qualityChanges.push_back({name, metric->getName(), previous, metric->getQuality(), metric->getTimestamp()});
+}
+
+Metric *Publishable::findMetric(const char *name, bool hasAlias, uint64_t alias)
+{
+    if (name)
+    {
+        return find(name);
+    }
+
+    if (hasAlias)
+    {
+        auto item = aliases.find(alias);
+        if (item != aliases.end())
+        {
+            return item->second;
+        }
+    }
+
+    return nullptr;
 }
@@ -42,13 +42,20 @@
 #include "CommonTypes.h"
 #include "TahuTypes.h"
 #include "Metric.h"
+#include "ModelContext.h"
+#include "ModelStatistics.h"
+#include "../utilities/PayloadReader.h"
+#include "../utilities/ObjectPool.h"
+#include <map>
+#include <unordered_set>
 #include <time.h>
 
 enum class PublishableState
 {
     ACTIVE,
     BIRTHED,
-    STALE
+    STALE,
+    RESTORED
 };
 
 enum class ActionState
@@ -63,6 +70,25 @@ enum class ChangedState
     CHANGES
 };
 
+/**
+ * @brief A session of a Publisher, ended by every birth and death
+ *
+ */
+struct PublisherSession
+{
+    uint32_t epoch = 0;
+    /**
+     * @brief The model version the last session ended at
+     *
+     */
+    uint64_t version = 0;
+    /**
+     * @brief The number of Devices counted as online in the session, they're all counted as stale when it ends
+     *
+     */
+    int64_t online = 0;
+};
+
 /**
  * @brief A class for representing a Sparkplug Publishable (e.g. Node, Device).
  *
@@ -78,13 +104,123 @@ private:
      * @return ParseResult
      */
     ParseResult loadPayload(tahu::Payload *payload, bool isBirth = false);
+    /**
+     * @brief Loads the Metrics of an encoded payload into the Publishable.
+     * Metrics that are unknown or unchanged are skipped without being decoded.
+     *
+     * @param reader
+     * @return ParseResult
+     */
+    ParseResult loadPayload(PayloadReader &reader);
+    /**
+     * @brief Finds the Metric for a name, falling back to its alias when it has no name
+     *
+     * @param name
+     * @param hasAlias
+     * @param alias
+     * @return Metric* The Metric, or nullptr if it's unknown
+     */
+    Metric *findMetric(const char *name, bool hasAlias, uint64_t alias);
+    /**
+     * @brief Reports a change to the Quality of a watched Metric
+     *
+     * @param metric
+     * @param previous The Quality of the Metric before it was processed
+     */
+    void reportQuality(Metric *metric, int32_t previous);
+    /**
+     * @brief Creates an empty Payload stamped with the time of the last valid message
+     *
+     * @return tahu::Payload*
+     */
+    tahu::Payload *createPayload();
+    /**
+     * @brief Advances the model version for a birth or death of the Publisher
+     *
+     */
+    void stamp();
+    /**
+     * @brief Catches the Publisher up with the model version if any of its Metrics changed while it was processed
+     *
+     * @param before The model version before the Publisher was processed
+     */
+    void advance(uint64_t before);
     time_t lastValidMessage = 0;
+    std::map<uint64_t, Metric *> aliases;
+    /**
+     * @brief How the Metrics changed in the last birth
+     *
+     */
+    std::shared_ptr<BirthDiff> diff;
+    /**
+     * @brief The latest model version of the Publisher or any of its Metrics
+     *
+     */
+    uint64_t version = 0;
+    /**
+     * @brief The model version of the last birth or death
+     *
+     */
+    uint64_t stateVersion = 0;
+    /**
+     * @brief Stales the Publisher once it has been inactive for its timeout
+     *
+     */
+    TimerEntry timeout{this};
+    uint32_t timeoutTicks = 0;
+    /**
+     * @brief The revision of the context's timeouts the timeout was looked up from
+     *
+     */
+    uint32_t timeoutRevision = 0;
+    /**
+     * @brief The session of the Node a Device belongs to, nullptr for Nodes
+     *
+     */
+    PublisherSession *parent = nullptr;
+    /**
+     * @brief The epoch of the parent's session the Publisher was last birthed or died in
+     *
+     */
+    uint32_t epoch = 0;
+    /**
+     * @brief Stales the Publisher if its parent's session ended since it was birthed.
+     * A Node's death stales its Devices through this check, without visiting each of them.
+     *
+     */
+    void synchronize();
+    /**
+     * @brief Changes the state of the Publisher, counting it as online or stale
+     *
+     * @param next
+     */
+    void setState(PublishableState next);
+    /**
+     * @brief The Metrics already applied while coalescing messages, nullptr when not coalescing
+     *
+     */
+    std::unordered_set<const Metric *> *coalesced = nullptr;
+    /**
+     * @brief Whether the Publisher is counted as online, Devices are no longer counted once their Node's session ends
+     *
+     * @return true
+     * @return false
+     */
+    bool isCounted();
 
 protected:
     std::string name;
+    ModelContext *context = nullptr;
+    MetricScope scope;
     PublishableState state = PublishableState::STALE;
     ActionState actionState = ActionState::NOTHING;
     ChangedState changedState = ChangedState::NOTHING;
+    PublisherSession session;
+    /**
+     * @brief The statistics the Publisher is counted in, nullptr if it isn't counted
+     *
+     */
+    ModelStatistics *statistics = nullptr;
 
 public:
     /**
@@ -98,6 +234,13 @@ public:
      * @param name
      */
     Publishable(std::string name);
+    /**
+     * @brief Construct a new Publishable with a unique name, sharing the state of a Sparkplug Host
+     *
+     * @param name
+     * @param context
+     */
+    Publishable(std::string name, ModelContext *context);
     virtual ~Publishable();
     /**
      * @brief Creates and appends a Payload to the list containing
@@ -105,17 +248,69 @@ public:
      *
      * @param payloads
      * @param force
+     * @param subscribers Only appends Metrics that match one of these subscribers
      */
-    void appendTo(std::vector<PublishableUpdate> &payloads, bool force = false);
+    void appendTo(std::vector<PublishableUpdate> &payloads, bool force = false, uint64_t subscribers = ALL_SUBSCRIBERS);
+    /**
+     * @brief Appends a Payload of the Metrics changed after a model version, without acknowledging any changes.
+     * If the Publisher was birthed or died after the version, its birth or death is appended instead.
+     *
+     * @param payloads
+     * @param since The model version
+     * @param subscribers Only appends Metrics that match one of these subscribers
+     */
+    void appendSince(std::vector<PublishableUpdate> &payloads, uint64_t since, uint64_t subscribers = ALL_SUBSCRIBERS);
+    /**
+     * @brief Gets the latest model version of the Publisher or any of its Metrics
+     *
+     * @return uint64_t
+     */
+    uint64_t getVersion();
+    /**
+     * @brief Matches every Metric of the Publisher against the Metric filters and deadbands.
+     * Metrics that weren't updated while they matched no filters have their values marked unknown
+     * once they match one again.
+     *
+     * @param current Whether every Metric was just birthed, so their values are current
+     */
+    void subscribe(bool current = false);
     /**
      * @brief Processes a payload for this Publisher
      * Will load all data from Metrics
      *
      * @param topic
      * @param payload
+     * @param reader A reader over the encoded payload when only its header has been decoded
      * @return ParseResult
      */
-    ParseResult process(SparkplugTopic &topic, tahu::Payload *payload);
+    ParseResult process(SparkplugTopic &topic, tahu::Payload *payload, PayloadReader *reader = nullptr);
+
+    /**
+     * @brief Restores the Publisher from a Payload written to a snapshot.
+     * The Publisher is known but unvalidated until it births again.
+     *
+     * @param payload
+     */
+    void restore(tahu::Payload *payload);
+    /**
+     * @brief Sets the Template definitions available to the Publisher's Template Metrics
+     *
+     * @param templates
+     */
+    void useTemplates(TemplateLibrary *templates);
+    /**
+     * @brief Allocates the Publisher's Metrics from a pool shared with its Node.
+     * Must be set before any Metrics are created.
+     *
+     * @param pool
+     */
+    void usePool(ObjectPool<Metric> *pool);
+    /**
+     * @brief Creates a Payload of all the Metrics of the Publisher for a snapshot
+     *
+     * @return tahu::Payload* The Payload, or nullptr if the Publisher isn't alive
+     */
+    tahu::Payload *snapshot();
 
     bool hasMetric(tahu::Metric &metric);
     /**
@@ -133,6 +328,49 @@ public:
      *
      */
     void active();
+    /**
+     * @brief Restarts the inactivity timer of the Publisher, if it's alive and has a timeout
+     *
+     */
+    void refresh();
+    /**
+     * @brief Marks the Publisher as Stale after its inactivity timer expired, reporting it as a death
+     *
+     */
+    void expire();
+    /**
+     * @brief Ties the Publisher to the session of its Node, it's staled whenever the Node is birthed or dies
+     *
+     * @param parent
+     */
+    void joinSession(PublisherSession *parent);
+    /**
+     * @brief Moves the Publisher to the statistics of a Group, it must be removed from them before it is destroyed
+     *
+     * @param statistics The statistics to count the Publisher in, or nullptr to remove it from its statistics
+     */
+    void useStatistics(ModelStatistics *statistics);
+    /**
+     * @brief Gets the statistics the Publisher is counted in
+     *
+     * @return ModelStatistics* The statistics, or nullptr if it isn't counted
+     */
+    ModelStatistics *getStatistics();
+    /**
+     * @brief Whether the Publisher's values may be out of date, as it's stale or hasn't been reborn since it was restored
+     *
+     * @return true
+     * @return false
+     */
+    bool isStale();
+    /**
+     * @brief Coalesces the data messages processed until it's cleared, applying each Metric only once.
+     * Messages are processed newest first, so each Metric keeps its last value.
+     *
+     * @param applied The Metrics applied so far, shared between the Publishers coalesced together.
+     * nullptr to stop coalescing.
+     */
+    void coalesce(std::unordered_set<const Metric *> *applied);
     /**
      * @brief Whether the Publisher is a Device
      *
@@ -140,6 +378,25 @@ public:
      * @return false
      */
     virtual inline bool isDevice() = 0;
+    /**
+     * @brief Whether the Publisher has been birthed or restored and hasn't died
+     *
+     * @return true
+     * @return false
+     */
+    bool isAlive();
+    /**
+     * @brief Get the name of the Publisher
+     *
+     * @return std::string&
+     */
+    std::string &getName();
+    /**
+     * @brief Gets how the Metrics changed in the last birth
+     *
+     * @return std::shared_ptr<const BirthDiff> The changes, or nullptr if the Publisher hasn't been birthed
+     */
+    std::shared_ptr<const BirthDiff> getBirthDiff();
 };
 
 #endif /* SRC_TYPES_PUBLISHABLE */
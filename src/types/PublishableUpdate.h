@@ -34,12 +34,35 @@
 
 #include "TahuTypes.h"
 #include <string>
+#include <vector>
+#include <memory>
 
 enum class UpdateType
 {
     PUBLISH = 0,
     DEATH,
-    BIRTH
+    BIRTH,
+    RESTORED
+};
+
+/**
+ * @brief How the Metrics of a Node or Device changed between births
+ *
+ */
+struct BirthDiff
+{
+    /**
+     * @brief Whether this was the first birth, the Metric lists are left empty as every Metric is new
+     *
+     */
+    bool initial = false;
+    std::vector<std::string> added;
+    std::vector<std::string> removed;
+    /**
+     * @brief Metrics that were birthed again with a different datatype
+     *
+     */
+    std::vector<std::string> retyped;
 };
 
 /**
@@ -54,6 +77,11 @@ public:
     tahu::Payload *payload = nullptr;
     std::string id;
     UpdateType type;
+    /**
+     * @brief How the Metrics changed since the previous birth, only set on births
+     *
+     */
+    std::shared_ptr<const BirthDiff> diff;
     PublishableUpdate() : payload(nullptr), type(UpdateType::DEATH){};
     PublishableUpdate(tahu::Payload *, std::string, UpdateType);
 };
@@ -34,6 +34,23 @@
 
 #include "tahu.h"
 
+// Sparkplug 3.0 array datatypes, carried as packed little endian bytes
+#ifndef METRIC_DATA_TYPE_INT8ARRAY
+#define METRIC_DATA_TYPE_INT8ARRAY 22
+#define METRIC_DATA_TYPE_INT16ARRAY 23
+#define METRIC_DATA_TYPE_INT32ARRAY 24
+#define METRIC_DATA_TYPE_INT64ARRAY 25
+#define METRIC_DATA_TYPE_UINT8ARRAY 26
+#define METRIC_DATA_TYPE_UINT16ARRAY 27
+#define METRIC_DATA_TYPE_UINT32ARRAY 28
+#define METRIC_DATA_TYPE_UINT64ARRAY 29
+#define METRIC_DATA_TYPE_FLOATARRAY 30
+#define METRIC_DATA_TYPE_DOUBLEARRAY 31
+#define METRIC_DATA_TYPE_BOOLEANARRAY 32
+#define METRIC_DATA_TYPE_STRINGARRAY 33
+#define METRIC_DATA_TYPE_DATETIMEARRAY 34
+#endif
+
 /**
  * @brief References Tahu types to an easier to read format
  *
@@ -47,7 +64,10 @@ namespace tahu
     typedef org_eclipse_tahu_protobuf_Payload_PropertyValue_PropertyValueExtension PropertyValueExtension;
     typedef org_eclipse_tahu_protobuf_Payload_PropertyValue Property;
     typedef org_eclipse_tahu_protobuf_Payload_DataSet DataSet;
+    typedef org_eclipse_tahu_protobuf_Payload_DataSet_Row DataSetRow;
+    typedef org_eclipse_tahu_protobuf_Payload_DataSet_DataSetValue DataSetValue;
     typedef org_eclipse_tahu_protobuf_Payload_Template Template;
+    typedef org_eclipse_tahu_protobuf_Payload_Template_Parameter Parameter;
     typedef org_eclipse_tahu_protobuf_Payload_Metric_MetricValueExtension MetricValueExtension;
 }
 
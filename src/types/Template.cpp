@@ -0,0 +1,389 @@
+/*
+ * File: Template.cpp
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#include "Template.h"
+#include <cstring>
+#include <cstdlib>
+
+using namespace std;
+
+TemplateDefinition::TemplateDefinition(string name, tahu::Template *source, TemplateLibrary *templates) : name(name)
+{
+    // Default values aren't accounted against the Bytes budget
+    MetricScope scope;
+    scope.templates = templates;
+
+    if (source->version)
+    {
+        version = source->version;
+    }
+
+    members.reserve(source->metrics_count);
+    defaults.reserve(source->metrics_count);
+
+    for (size_t i = 0; i < source->metrics_count; i++)
+    {
+        tahu::Metric *member = &source->metrics[i];
+
+        if (!member->name)
+        {
+            continue;
+        }
+
+        index[member->name] = members.size();
+        members.push_back(member->name);
+        defaults.emplace_back();
+        defaults.back().process(member, &scope);
+    }
+
+    parameters.reserve(source->parameters_count);
+    parameterDefaults.reserve(source->parameters_count);
+
+    for (size_t i = 0; i < source->parameters_count; i++)
+    {
+        tahu::Parameter *parameter = &source->parameters[i];
+
+        if (!parameter->name)
+        {
+            continue;
+        }
+
+        parameters.push_back(parameter->name);
+        parameterDefaults.emplace_back();
+        parameterDefaults.back().process(parameter);
+    }
+}
+
+int TemplateDefinition::indexOf(const char *member) const
+{
+    auto item = index.find(member);
+    return item != index.end() ? (int)item->second : -1;
+}
+
+int TemplateDefinition::indexOfParameter(const char *parameter) const
+{
+    for (size_t i = 0; i < parameters.size(); i++)
+    {
+        if (parameters[i].compare(parameter) == 0)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void TemplateDefinition::appendTo(tahu::Payload *payload)
+{
+    tahu::Metric metric;
+    memset(&metric, 0, sizeof(tahu::Metric));
+
+    metric.name = strdup(name.c_str());
+    metric.has_datatype = true;
+    metric.datatype = METRIC_DATA_TYPE_TEMPLATE;
+    metric.which_value = org_eclipse_tahu_protobuf_Payload_Metric_template_value_tag;
+
+    tahu::Template &target = metric.value.template_value;
+    target.has_is_definition = target.is_definition = true;
+    target.version = version.empty() ? nullptr : strdup(version.c_str());
+
+    if (!members.empty())
+    {
+        target.metrics = (tahu::Metric *)calloc(members.size(), sizeof(tahu::Metric));
+        target.metrics_count = members.size();
+
+        for (size_t i = 0; i < members.size(); i++)
+        {
+            target.metrics[i].name = strdup(members[i].c_str());
+            defaults[i].appendTo(&target.metrics[i]);
+        }
+    }
+
+    if (!parameters.empty())
+    {
+        target.parameters = (tahu::Parameter *)calloc(parameters.size(), sizeof(tahu::Parameter));
+        target.parameters_count = parameters.size();
+
+        for (size_t i = 0; i < parameters.size(); i++)
+        {
+            target.parameters[i].name = strdup(parameters[i].c_str());
+            parameterDefaults[i].appendTo(&target.parameters[i]);
+        }
+    }
+
+    add_metric_to_payload(payload, &metric);
+}
+
+const string &TemplateDefinition::getName() const
+{
+    return name;
+}
+
+const string &TemplateDefinition::getVersion() const
+{
+    return version;
+}
+
+size_t TemplateDefinition::getMemberCount() const
+{
+    return members.size();
+}
+
+const string &TemplateDefinition::getMemberName(size_t index) const
+{
+    return members[index];
+}
+
+size_t TemplateDefinition::getParameterCount() const
+{
+    return parameters.size();
+}
+
+const string &TemplateDefinition::getParameterName(size_t index) const
+{
+    return parameters[index];
+}
+
+TemplateInstance::TemplateInstance(shared_ptr<const TemplateDefinition> definition)
+    : definition(definition),
+      members(definition->getMemberCount()),
+      parameters(definition->getParameterCount()),
+      dirty(definition->getMemberCount(), false),
+      memberReferences(definition->getMemberCount()),
+      parameterReferences(definition->getParameterCount())
+{
+}
+
+ParseResult TemplateInstance::process(tahu::Template *source, MetricScope *scope, bool &changed)
+{
+    const Deadband exact;
+    changed = false;
+
+    for (size_t i = 0; i < source->metrics_count; i++)
+    {
+        tahu::Metric *member = &source->metrics[i];
+        int position = member->name ? definition->indexOf(member->name) : -1;
+
+        if (position < 0)
+        {
+            continue;
+        }
+
+        if (members[position].process(member, scope) == ParseResult::OUT_OF_SYNC)
+        {
+            return ParseResult::OUT_OF_SYNC;
+        }
+
+        Reference &reference = memberReferences[position];
+        if (members[position].update(exact, reference.bits, reference.valid))
+        {
+            dirty[position] = true;
+            changed = true;
+        }
+    }
+
+    for (size_t i = 0; i < source->parameters_count; i++)
+    {
+        tahu::Parameter *parameter = &source->parameters[i];
+        int position = parameter->name ? definition->indexOfParameter(parameter->name) : -1;
+
+        if (position < 0)
+        {
+            continue;
+        }
+
+        if (parameters[position].process(parameter) == ParseResult::OUT_OF_SYNC)
+        {
+            return ParseResult::OUT_OF_SYNC;
+        }
+
+        Reference &reference = parameterReferences[position];
+        if (parameters[position].update(exact, reference.bits, reference.valid))
+        {
+            parametersDirty = true;
+            changed = true;
+        }
+    }
+
+    return ParseResult::OK;
+}
+
+void TemplateInstance::appendTo(tahu::Template *target, bool force)
+{
+    target->template_ref = strdup(definition->getName().c_str());
+    target->has_is_definition = true;
+    target->is_definition = false;
+
+    if (!definition->getVersion().empty())
+    {
+        target->version = strdup(definition->getVersion().c_str());
+    }
+
+    size_t count = 0;
+    for (size_t i = 0; i < members.size(); i++)
+    {
+        count += force || dirty[i];
+    }
+
+    if (count > 0)
+    {
+        target->metrics = (tahu::Metric *)calloc(count, sizeof(tahu::Metric));
+
+        for (size_t i = 0; i < members.size(); i++)
+        {
+            if (!force && !dirty[i])
+            {
+                continue;
+            }
+
+            tahu::Metric *member = &target->metrics[target->metrics_count++];
+            member->name = strdup(definition->getMemberName(i).c_str());
+            members[i].appendTo(member, force);
+
+            if (!force)
+            {
+                dirty[i] = false;
+                members[i].acknowledge();
+            }
+        }
+    }
+
+    if (!force && !parametersDirty)
+    {
+        return;
+    }
+
+    if (!force)
+    {
+        parametersDirty = false;
+    }
+
+    count = 0;
+    for (auto &parameter : parameters)
+    {
+        count += !parameter.isNull();
+    }
+
+    if (count == 0)
+    {
+        return;
+    }
+
+    target->parameters = (tahu::Parameter *)calloc(count, sizeof(tahu::Parameter));
+
+    for (size_t i = 0; i < parameters.size(); i++)
+    {
+        if (parameters[i].isNull())
+        {
+            continue;
+        }
+
+        tahu::Parameter *parameter = &target->parameters[target->parameters_count++];
+        parameter->name = strdup(definition->getParameterName(i).c_str());
+        parameters[i].appendTo(parameter);
+    }
+}
+
+bool TemplateInstance::isDirty()
+{
+    if (parametersDirty)
+    {
+        return true;
+    }
+
+    for (bool changed : dirty)
+    {
+        if (changed)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+const TemplateDefinition &TemplateInstance::getDefinition() const
+{
+    return *definition;
+}
+
+MetricValue &TemplateInstance::getMember(size_t index)
+{
+    return members[index];
+}
+
+MetricValue &TemplateInstance::getParameter(size_t index)
+{
+    return parameters[index];
+}
+
+void TemplateLibrary::define(const string &name, tahu::Template *source)
+{
+    auto definition = make_shared<TemplateDefinition>(name, source, this);
+    auto item = index.find(name);
+
+    if (item != index.end())
+    {
+        definitions[item->second] = definition;
+        return;
+    }
+
+    index[name] = definitions.size();
+    definitions.push_back(definition);
+}
+
+shared_ptr<const TemplateDefinition> TemplateLibrary::find(const string &name)
+{
+    auto item = index.find(name);
+    if (item == index.end())
+    {
+        return nullptr;
+    }
+    return definitions[item->second];
+}
+
+void TemplateLibrary::appendTo(tahu::Payload *payload)
+{
+    for (auto &definition : definitions)
+    {
+        definition->appendTo(payload);
+    }
+}
+
+void TemplateLibrary::clear()
+{
+    definitions.clear();
+    index.clear();
+}
+
+size_t TemplateLibrary::size()
+{
+    return definitions.size();
+}
@@ -0,0 +1,211 @@
+/*
+ * File: Template.h
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#ifndef SRC_TYPES_TEMPLATE
+#define SRC_TYPES_TEMPLATE
+
+#include "TahuTypes.h"
+#include "CommonTypes.h"
+#include "MetricValue.h"
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+
+class TemplateLibrary;
+
+/**
+ * @brief A Sparkplug Template definition (UDT) birthed by a Node.
+ * Holds the names and default values of the Template's members and parameters,
+ * shared by every instance of the Template.
+ *
+ */
+class TemplateDefinition
+{
+private:
+    std::string name;
+    std::string version;
+    std::vector<std::string> members;
+    std::vector<MetricValue> defaults;
+    std::map<std::string, size_t> index;
+    std::vector<std::string> parameters;
+    std::vector<MetricValue> parameterDefaults;
+
+protected:
+public:
+    /**
+     * @brief Construct a new Template definition from a birthed definition
+     *
+     * @param name
+     * @param source
+     * @param templates The definitions of any Templates nested in this definition
+     */
+    TemplateDefinition(std::string name, tahu::Template *source, TemplateLibrary *templates);
+    /**
+     * @brief Finds the index of a member
+     *
+     * @param member
+     * @return int The index of the member, or -1 if the Template has no such member
+     */
+    int indexOf(const char *member) const;
+    /**
+     * @brief Finds the index of a parameter
+     *
+     * @param parameter
+     * @return int The index of the parameter, or -1 if the Template has no such parameter
+     */
+    int indexOfParameter(const char *parameter) const;
+    /**
+     * @brief Appends the definition to a Payload as a Template definition Metric
+     *
+     * @param payload
+     */
+    void appendTo(tahu::Payload *payload);
+    const std::string &getName() const;
+    const std::string &getVersion() const;
+    size_t getMemberCount() const;
+    const std::string &getMemberName(size_t index) const;
+    size_t getParameterCount() const;
+    const std::string &getParameterName(size_t index) const;
+};
+
+/**
+ * @brief An instance of a Sparkplug Template.
+ * Members are stored by their index in the definition, and changes are tracked per member so
+ * only the changed members are reported.
+ *
+ */
+class TemplateInstance
+{
+private:
+    std::shared_ptr<const TemplateDefinition> definition;
+    std::vector<MetricValue> members;
+    std::vector<MetricValue> parameters;
+    std::vector<bool> dirty;
+    bool parametersDirty = false;
+
+    /**
+     * @brief The last changed value of a member or parameter, see MetricValue::update()
+     *
+     */
+    struct Reference
+    {
+        uint64_t bits = 0;
+        bool valid = false;
+    };
+    std::vector<Reference> memberReferences;
+    std::vector<Reference> parameterReferences;
+
+protected:
+public:
+    TemplateInstance(std::shared_ptr<const TemplateDefinition> definition);
+    /**
+     * @brief Processes the members and parameters of a Template value.
+     * Partial updates only change the members they include, and only members whose values changed are flagged.
+     *
+     * @param source
+     * @param scope The definitions of any nested Templates and the Bytes budget
+     * @param changed Set to whether any member or parameter differs from its last changed value
+     * @return ParseResult
+     */
+    ParseResult process(tahu::Template *source, MetricScope *scope, bool &changed);
+    /**
+     * @brief Writes the instance to a Template value
+     *
+     * @param target
+     * @param force Writes all members instead of the changed members, without acknowledging the changes
+     */
+    void appendTo(tahu::Template *target, bool force);
+    /**
+     * @brief Whether any members have changed since they were last appended
+     *
+     * @return true
+     * @return false
+     */
+    bool isDirty();
+    const TemplateDefinition &getDefinition() const;
+    /**
+     * @brief Gets the value of a member by its index in the definition
+     *
+     * @param index
+     * @return MetricValue&
+     */
+    MetricValue &getMember(size_t index);
+    /**
+     * @brief Gets the value of a parameter by its index in the definition
+     *
+     * @param index
+     * @return MetricValue&
+     */
+    MetricValue &getParameter(size_t index);
+};
+
+/**
+ * @brief The Template definitions birthed by a Node, shared by the Node and its Devices
+ *
+ */
+class TemplateLibrary
+{
+private:
+    std::vector<std::shared_ptr<TemplateDefinition>> definitions;
+    std::map<std::string, size_t> index;
+
+protected:
+public:
+    /**
+     * @brief Adds or replaces a Template definition
+     *
+     * @param name
+     * @param source
+     */
+    void define(const std::string &name, tahu::Template *source);
+    /**
+     * @brief Finds a Template definition
+     *
+     * @param name
+     * @return std::shared_ptr<const TemplateDefinition> The definition, or empty if it's unknown
+     */
+    std::shared_ptr<const TemplateDefinition> find(const std::string &name);
+    /**
+     * @brief Appends all definitions to a Payload, in the order they were defined
+     *
+     * @param payload
+     */
+    void appendTo(tahu::Payload *payload);
+    /**
+     * @brief Removes all definitions. Existing instances keep their definitions.
+     *
+     */
+    void clear();
+    size_t size();
+};
+
+#endif /* SRC_TYPES_TEMPLATE */
@@ -0,0 +1,71 @@
+/*
+ * File: ChangeFilters.cpp
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#include "ChangeFilters.h"
+#include <bit>
+
+using namespace std;
+
+int ChangeFilters::add(const string &pattern, Deadband deadband, const set<uint32_t> &datatypes)
+{
+    int id = patterns.add(pattern, datatypes);
+    if (id >= 0)
+    {
+        deadbands[id] = deadband;
+    }
+    return id;
+}
+
+void ChangeFilters::remove(int id)
+{
+    patterns.remove(id);
+}
+
+void ChangeFilters::setDefault(Deadband deadband)
+{
+    fallback = deadband;
+}
+
+Deadband ChangeFilters::match(const string &publisher, bool isDevice, const string &metric, uint32_t datatype) const
+{
+    if (patterns.empty())
+    {
+        return fallback;
+    }
+
+    uint64_t matches = patterns.match(publisher, isDevice, metric, datatype);
+    if (matches == 0)
+    {
+        return fallback;
+    }
+
+    return deadbands[countr_zero(matches)];
+}
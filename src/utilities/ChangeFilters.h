@@ -0,0 +1,123 @@
+/*
+ * File: ChangeFilters.h
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#ifndef SRC_UTILITIES_CHANGEFILTERS
+#define SRC_UTILITIES_CHANGEFILTERS
+
+#include "MetricFilters.h"
+
+/**
+ * @brief How a Metric's new value is compared with its last changed value
+ *
+ */
+enum class ChangeMode : uint8_t
+{
+    /**
+     * @brief Every value is a change
+     *
+     */
+    ANY,
+    /**
+     * @brief Values are changes when they differ from the last changed value
+     *
+     */
+    EXACT,
+    /**
+     * @brief Numeric values are changes when they differ from the last changed value by more than the deadband
+     *
+     */
+    ABSOLUTE,
+    /**
+     * @brief Numeric values are changes when they differ from the last changed value by more than the deadband,
+     * as a percentage of the last changed value
+     *
+     */
+    PERCENT
+};
+
+/**
+ * @brief The change detection used for a Metric.
+ * Strings are compared by hash and Booleans exactly regardless of the mode.
+ *
+ */
+struct Deadband
+{
+    ChangeMode mode = ChangeMode::EXACT;
+    float amount = 0;
+};
+
+/**
+ * @brief Assigns deadbands to Metrics using filters in the same form as MetricFilters.
+ * When several filters match a Metric, the filter with the lowest id applies.
+ *
+ */
+class ChangeFilters
+{
+private:
+    MetricFilters patterns;
+    Deadband deadbands[MAX_METRIC_FILTERS];
+    Deadband fallback;
+
+public:
+    /**
+     * @brief Registers a deadband for the Metrics matching a filter
+     *
+     * @param pattern The path pattern of the filter
+     * @param deadband
+     * @param datatypes The Metric datatypes the filter matches. Matches all datatypes if empty.
+     * @return int The id of the filter, or -1 if no more filters can be registered
+     */
+    int add(const std::string &pattern, Deadband deadband, const std::set<uint32_t> &datatypes = {});
+    /**
+     * @brief Removes a filter
+     *
+     * @param id
+     */
+    void remove(int id);
+    /**
+     * @brief Sets the deadband of Metrics that don't match any filter
+     *
+     * @param deadband
+     */
+    void setDefault(Deadband deadband);
+    /**
+     * @brief Gets the deadband of a Metric
+     *
+     * @param publisher The name of the Node (group/node) or Device (group/node/device) the Metric belongs to
+     * @param isDevice Whether the publisher is a Device
+     * @param metric The name of the Metric
+     * @param datatype The datatype of the Metric
+     * @return Deadband
+     */
+    Deadband match(const std::string &publisher, bool isDevice, const std::string &metric, uint32_t datatype) const;
+};
+
+#endif /* SRC_UTILITIES_CHANGEFILTERS */
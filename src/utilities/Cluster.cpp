@@ -0,0 +1,168 @@
+/*
+ * File: Cluster.cpp
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#include "Cluster.h"
+
+using namespace std;
+using namespace std::chrono;
+
+#define MISSED_HEARTBEATS 3
+
+/**
+ * @brief A hash that is stable between processes, so all instances agree on ownership
+ *
+ */
+static uint64_t score(const string &member, const string &key)
+{
+    uint64_t digest = 14695981039346656037ULL;
+
+    for (char value : member)
+    {
+        digest = (digest ^ (uint8_t)value) * 1099511628211ULL;
+    }
+
+    digest = (digest ^ '/') * 1099511628211ULL;
+
+    for (char value : key)
+    {
+        digest = (digest ^ (uint8_t)value) * 1099511628211ULL;
+    }
+
+    // Finalizer to spread the FNV bits
+    digest ^= digest >> 33;
+    digest *= 0xff51afd7ed558ccdULL;
+    digest ^= digest >> 33;
+    return digest;
+}
+
+Cluster::Cluster(string name, string instance, ClusterPartition partition, milliseconds interval)
+    : name(name), instance(instance), partition(partition), interval(interval)
+{
+    topic = string(CLUSTER_TOPIC_PREFIX) + "/" + name + "/" + instance;
+    filter = string(CLUSTER_TOPIC_PREFIX) + "/" + name + "/+";
+    members[instance] = steady_clock::time_point::max();
+}
+
+bool Cluster::isOwner(const string &key) const
+{
+    const string *owner = nullptr;
+    uint64_t highest = 0;
+
+    for (auto &[member, seen] : members)
+    {
+        uint64_t value = score(member, key);
+        if (!owner || value > highest)
+        {
+            owner = &member;
+            highest = value;
+        }
+    }
+
+    return owner && *owner == instance;
+}
+
+bool Cluster::owns(const string &group, const string &node) const
+{
+    if (partition == ClusterPartition::GROUP)
+    {
+        return isOwner(group);
+    }
+
+    return isOwner(group + "/" + node);
+}
+
+bool Cluster::owns(const string &group) const
+{
+    if (partition == ClusterPartition::NODE)
+    {
+        return true;
+    }
+
+    return isOwner(group);
+}
+
+bool Cluster::isMembership(const string &topic) const
+{
+    return topic.size() > filter.size() - 1 && topic.compare(0, filter.size() - 1, filter, 0, filter.size() - 1) == 0;
+}
+
+bool Cluster::update(const string &topic, const string &payload)
+{
+    string member = topic.substr(filter.size() - 1);
+
+    if (member == instance)
+    {
+        return false;
+    }
+
+    if (payload == CLUSTER_OFFLINE)
+    {
+        return members.erase(member) > 0;
+    }
+
+    bool joined = !members.contains(member);
+    members[member] = steady_clock::now();
+    return joined;
+}
+
+bool Cluster::expire()
+{
+    auto deadline = steady_clock::now() - interval * MISSED_HEARTBEATS;
+
+    return erase_if(members, [deadline](const pair<const string, steady_clock::time_point> &member)
+                    { return member.second < deadline; }) > 0;
+}
+
+bool Cluster::heartbeat()
+{
+    auto now = steady_clock::now();
+    if (now - lastHeartbeat < interval)
+    {
+        return false;
+    }
+    lastHeartbeat = now;
+    return true;
+}
+
+ClusterPartition Cluster::getPartition() const
+{
+    return partition;
+}
+
+const string &Cluster::getTopic() const
+{
+    return topic;
+}
+
+const string &Cluster::getFilter() const
+{
+    return filter;
+}
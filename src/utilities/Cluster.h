@@ -0,0 +1,155 @@
+/*
+ * File: Cluster.h
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#ifndef SRC_UTILITIES_CLUSTER
+#define SRC_UTILITIES_CLUSTER
+
+#include <string>
+#include <map>
+#include <chrono>
+
+#define CLUSTER_TOPIC_PREFIX "sparkplug_host_cluster"
+#define CLUSTER_ONLINE "online"
+#define CLUSTER_OFFLINE "offline"
+
+/**
+ * @brief How the Groups and Nodes on the network are partitioned between the instances of a cluster
+ *
+ */
+enum class ClusterPartition
+{
+    GROUP,
+    NODE
+};
+
+/**
+ * @brief Tracks the instances of a cluster of Sparkplug Hosts and the partition each instance owns.
+ * Instances announce themselves with heartbeats on a membership topic and expire when their heartbeats stop.
+ * Ownership is decided with rendezvous hashing, so every instance agrees on an owner and only the
+ * partitions of an instance that joins or leaves move.
+ *
+ */
+class Cluster
+{
+private:
+    std::string name;
+    std::string instance;
+    ClusterPartition partition;
+    std::string topic;
+    std::string filter;
+    std::chrono::milliseconds interval;
+    std::chrono::steady_clock::time_point lastHeartbeat;
+    std::map<std::string, std::chrono::steady_clock::time_point> members;
+
+    /**
+     * @brief Whether this instance has the highest rendezvous score of all members for a key
+     *
+     * @param key
+     * @return true
+     * @return false
+     */
+    bool isOwner(const std::string &key) const;
+
+protected:
+public:
+    /**
+     * @brief Construct a new Cluster
+     *
+     * @param name The name of the cluster, shared by all instances
+     * @param instance The unique id of this instance
+     * @param partition How Groups and Nodes are partitioned
+     * @param interval How often heartbeats are published. Instances expire after three missed heartbeats.
+     */
+    Cluster(std::string name, std::string instance, ClusterPartition partition, std::chrono::milliseconds interval);
+    /**
+     * @brief Whether this instance owns a Group or Node
+     *
+     * @param group
+     * @param node
+     * @return true
+     * @return false
+     */
+    bool owns(const std::string &group, const std::string &node) const;
+    /**
+     * @brief Whether this instance owns a Group. Always true when partitioning by Node.
+     *
+     * @param group
+     * @return true
+     * @return false
+     */
+    bool owns(const std::string &group) const;
+    /**
+     * @brief Whether a topic is a membership topic of this cluster
+     *
+     * @param topic
+     * @return true
+     * @return false
+     */
+    bool isMembership(const std::string &topic) const;
+    /**
+     * @brief Updates the members of the cluster from a membership message
+     *
+     * @param topic
+     * @param payload
+     * @return true The members changed
+     * @return false
+     */
+    bool update(const std::string &topic, const std::string &payload);
+    /**
+     * @brief Expires any members whose heartbeats have stopped
+     *
+     * @return true The members changed
+     * @return false
+     */
+    bool expire();
+    /**
+     * @brief Whether this instance is due to publish a heartbeat, restarting the interval if it is
+     *
+     * @return true
+     * @return false
+     */
+    bool heartbeat();
+    ClusterPartition getPartition() const;
+    /**
+     * @brief The topic this instance publishes its heartbeats on
+     *
+     * @return const std::string&
+     */
+    const std::string &getTopic() const;
+    /**
+     * @brief The topic filter for the heartbeats of all instances
+     *
+     * @return const std::string&
+     */
+    const std::string &getFilter() const;
+};
+
+#endif /* SRC_UTILITIES_CLUSTER */
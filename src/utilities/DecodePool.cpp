@@ -0,0 +1,151 @@
+/*
+ * File: DecodePool.cpp
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#include "DecodePool.h"
+
+using namespace std;
+
+DecodePool::DecodePool(size_t threads)
+{
+    for (size_t i = 0; i < threads; i++)
+    {
+        workers.emplace_back(&DecodePool::work, this);
+    }
+}
+
+DecodePool::~DecodePool()
+{
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+    }
+
+    available.notify_all();
+
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+}
+
+void DecodePool::decode(const vector<mqtt::const_message_ptr> &messages, vector<DecodedMessage> &decoded, function<bool(SparkplugTopic &)> accept)
+{
+    decoded.resize(messages.size());
+
+    sources = &messages;
+    results = &decoded;
+    this->accept = accept;
+    next = 0;
+
+    if (workers.empty() || messages.size() < 2)
+    {
+        process();
+        return;
+    }
+
+    {
+        lock_guard<mutex> guard(lock);
+        active = workers.size();
+        generation++;
+    }
+
+    available.notify_all();
+
+    // The calling thread decodes alongside the workers
+    process();
+
+    unique_lock<mutex> guard(lock);
+    completed.wait(guard, [this]()
+                   { return active == 0; });
+}
+
+void DecodePool::process()
+{
+    size_t index;
+
+    while ((index = next.fetch_add(1)) < sources->size())
+    {
+        auto &source = (*sources)[index];
+        DecodedMessage &result = (*results)[index];
+        result.message.payload = nullptr;
+        result.message.source.reset();
+        result.reader.reset();
+
+        result.message.topic = source->get_topic();
+        if (!result.topic.parse(result.message.topic) || (accept && !accept(result.topic)))
+        {
+            continue;
+        }
+
+        if (result.topic.isData())
+        {
+            // Walking the Metrics here leaves only decoding the changed Metrics to the serial apply
+            if (SparkplugReceiver::decodeHeader(source, result.message))
+            {
+                const mqtt::binary &raw = source->get_payload();
+                result.reader.reset(new PayloadReader((const uint8_t *)raw.data(), raw.length()));
+                result.reader->index();
+            }
+        }
+        else
+        {
+            SparkplugReceiver::decode(source, result.message);
+        }
+    }
+}
+
+void DecodePool::work()
+{
+    uint64_t seen = 0;
+    unique_lock<mutex> guard(lock);
+
+    while (true)
+    {
+        available.wait(guard, [this, &seen]()
+                       { return stopping || generation != seen; });
+
+        if (stopping)
+        {
+            return;
+        }
+
+        seen = generation;
+
+        guard.unlock();
+        process();
+        guard.lock();
+
+        if (--active == 0)
+        {
+            completed.notify_one();
+        }
+    }
+}
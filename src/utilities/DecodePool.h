@@ -0,0 +1,113 @@
+/*
+ * File: DecodePool.h
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#ifndef SRC_UTILITIES_DECODEPOOL
+#define SRC_UTILITIES_DECODEPOOL
+
+#include "../SparkplugReceiver.h"
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+/**
+ * @brief A received message along with its parsed topic
+ *
+ */
+struct DecodedMessage
+{
+    SparkplugMessage message;
+    SparkplugTopic topic;
+    /**
+     * @brief The indexed Metrics of a data message, reading the raw message kept in the SparkplugMessage
+     *
+     */
+    std::unique_ptr<PayloadReader> reader;
+};
+
+/**
+ * @brief A pool of threads for decoding raw MQTT messages into Sparkplug messages.
+ * Decoded messages are stored in the same position as their raw message, keeping the arrival order.
+ * Data messages only have their header decoded and their Metrics indexed, the Metrics that changed are decoded
+ * when they are applied.
+ *
+ */
+class DecodePool
+{
+private:
+    std::vector<std::thread> workers;
+    std::mutex lock;
+    std::condition_variable available;
+    std::condition_variable completed;
+    uint64_t generation = 0;
+    size_t active = 0;
+    bool stopping = false;
+
+    const std::vector<mqtt::const_message_ptr> *sources = nullptr;
+    std::vector<DecodedMessage> *results = nullptr;
+    std::function<bool(SparkplugTopic &)> accept;
+    std::atomic<size_t> next = 0;
+
+    /**
+     * @brief Decodes messages from the current batch until none are left
+     *
+     */
+    void process();
+    /**
+     * @brief Worker thread loop, waits for batches and decodes them
+     *
+     */
+    void work();
+
+protected:
+public:
+    /**
+     * @brief Construct a new Decode Pool
+     *
+     * @param threads The number of worker threads. With no threads messages are decoded by the caller.
+     */
+    DecodePool(size_t threads);
+    ~DecodePool();
+    /**
+     * @brief Decodes a batch of raw messages, blocking until every message is decoded.
+     * Messages that fail to decode, or that aren't on a Sparkplug topic, will have a null payload.
+     *
+     * @param messages The raw messages
+     * @param decoded Filled with the decoded messages, in the same order as the raw messages
+     * @param accept Optionally selects which topics are decoded, other messages are left with a null payload
+     */
+    void decode(const std::vector<mqtt::const_message_ptr> &messages, std::vector<DecodedMessage> &decoded, std::function<bool(SparkplugTopic &)> accept = nullptr);
+};
+
+#endif /* SRC_UTILITIES_DECODEPOOL */
@@ -0,0 +1,132 @@
+/*
+ * File: IngestQueue.cpp
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#include "IngestQueue.h"
+#include "SparkplugTopic.h"
+
+const std::string STATE_PREFIX{"spBv1.0/STATE/"};
+
+void IngestQueue::push(mqtt::const_message_ptr message, int64_t received)
+{
+    std::string topicName = message->get_topic();
+    SparkplugTopic topic;
+
+    IngestEntry entry{message, received, arrivals++, false};
+    std::string key;
+
+    if (topic.parse(topicName))
+    {
+        // Device messages share the lane of their Node, as they share its sequence
+        key = topic.getGroup() + "/" + topic.getNode();
+        entry.lifecycle = topic.isBirth() || topic.isDeath();
+    }
+    else
+    {
+        key = topicName;
+        // Host STATE is a lifecycle message of its own
+        entry.lifecycle = topicName.compare(0, STATE_PREFIX.size(), STATE_PREFIX) == 0;
+    }
+
+    if (entry.lifecycle)
+    {
+        priority.emplace_back(entry.arrival, key);
+    }
+    order.emplace_back(entry.arrival, key);
+
+    lanes[key].push_back(std::move(entry));
+    count++;
+}
+
+bool IngestQueue::isTaken(const std::pair<uint64_t, std::string> &arrival)
+{
+    // Messages leave their Node in order, so a Node whose oldest message is newer has already given this one up
+    auto match = lanes.find(arrival.second);
+    return match == lanes.end() || match->second.front().arrival > arrival.first;
+}
+
+bool IngestQueue::take(std::deque<std::pair<uint64_t, std::string>> &arrivals, IngestEntry &entry)
+{
+    if (isTaken(arrivals.front()))
+    {
+        arrivals.pop_front();
+        return false;
+    }
+
+    auto match = lanes.find(arrivals.front().second);
+
+    entry = std::move(match->second.front());
+    match->second.pop_front();
+    count--;
+
+    if (entry.arrival == arrivals.front().first)
+    {
+        arrivals.pop_front();
+    }
+
+    if (match->second.empty())
+    {
+        lanes.erase(match);
+    }
+
+    return true;
+}
+
+bool IngestQueue::pop(IngestEntry &entry)
+{
+    while (!priority.empty())
+    {
+        if (take(priority, entry))
+        {
+            while (!order.empty() && isTaken(order.front()))
+            {
+                order.pop_front();
+            }
+
+            entry.promoted = !order.empty() && order.front().first < entry.arrival;
+            return true;
+        }
+    }
+
+    while (!order.empty())
+    {
+        if (take(order, entry))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+size_t IngestQueue::size() const
+{
+    return count;
+}
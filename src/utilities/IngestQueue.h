@@ -0,0 +1,134 @@
+/*
+ * File: IngestQueue.h
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#ifndef SRC_UTILITIES_INGESTQUEUE
+#define SRC_UTILITIES_INGESTQUEUE
+
+#include "mqtt/async_client.h"
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * @brief A raw message waiting in an IngestQueue
+ *
+ */
+struct IngestEntry
+{
+    mqtt::const_message_ptr message;
+    /**
+     * @brief When the message was taken from the client, in microseconds since the epoch
+     *
+     */
+    int64_t received = 0;
+    uint64_t arrival = 0;
+    bool lifecycle = false;
+    /**
+     * @brief Whether the message was taken ahead of a message that arrived before it
+     *
+     */
+    bool promoted = false;
+};
+
+/**
+ * @brief Holds received messages before they are decoded, letting lifecycle messages (births, deaths and
+ * Host STATE) jump ahead of a backlog of data messages.
+ * Messages are queued per Node, and a Node with a lifecycle message waiting is taken first along with the
+ * messages it received before it. Messages for a Node always leave in the order they arrived.
+ *
+ */
+class IngestQueue
+{
+private:
+    /**
+     * @brief The messages of each Node by group/node, in the order they arrived
+     *
+     */
+    std::unordered_map<std::string, std::deque<IngestEntry>> lanes;
+    /**
+     * @brief The arrival and Node of every message, entries taken early are skipped
+     *
+     */
+    std::deque<std::pair<uint64_t, std::string>> order;
+    /**
+     * @brief The arrival and Node of every lifecycle message
+     *
+     */
+    std::deque<std::pair<uint64_t, std::string>> priority;
+    uint64_t arrivals = 0;
+    size_t count = 0;
+
+    /**
+     * @brief Whether a message was already taken along with a lifecycle message that arrived after it
+     *
+     * @param arrival The arrival and Node of the message
+     * @return true
+     * @return false
+     */
+    bool isTaken(const std::pair<uint64_t, std::string> &arrival);
+    /**
+     * @brief Takes the oldest message of the Node at the front of a list of arrivals
+     *
+     * @param arrivals Either every arrival or the arrivals of lifecycle messages
+     * @param entry Filled with the message
+     * @return true If a message was taken
+     * @return false The message at the front of the list was already taken, and was removed
+     */
+    bool take(std::deque<std::pair<uint64_t, std::string>> &arrivals, IngestEntry &entry);
+
+protected:
+public:
+    /**
+     * @brief Queues a received message
+     *
+     * @param message
+     * @param received When the message was taken from the client, in microseconds since the epoch
+     */
+    void push(mqtt::const_message_ptr message, int64_t received);
+    /**
+     * @brief Takes the next message, lifecycle messages and the messages before them on the same Node first
+     *
+     * @param entry Filled with the message
+     * @return true If a message was taken
+     * @return false The queue is empty
+     */
+    bool pop(IngestEntry &entry);
+    /**
+     * @brief Gets the number of queued messages
+     *
+     * @return size_t
+     */
+    size_t size() const;
+};
+
+#endif /* SRC_UTILITIES_INGESTQUEUE */
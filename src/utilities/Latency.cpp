@@ -0,0 +1,224 @@
+/*
+ * File: Latency.cpp
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#include "Latency.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
+/**
+ * @brief Gets the bucket of a duration, mirrored around the middle bucket for negative durations
+ *
+ */
+static inline size_t bucketOf(int64_t duration)
+{
+    uint64_t magnitude = duration < 0 ? -(uint64_t)duration : duration;
+    size_t offset = std::min<size_t>(std::bit_width(magnitude), LATENCY_BUCKETS - 1);
+
+    return duration < 0 ? LATENCY_BUCKETS - 1 - offset : LATENCY_BUCKETS - 1 + offset;
+}
+
+/**
+ * @brief Gets the bound of a bucket closest to positive infinity
+ *
+ */
+static inline int64_t upperOf(size_t bucket)
+{
+    if (bucket >= LATENCY_BUCKETS - 1)
+    {
+        size_t offset = bucket - (LATENCY_BUCKETS - 1);
+        return offset == 0 ? 0 : ((int64_t)1 << offset) - 1;
+    }
+
+    size_t offset = LATENCY_BUCKETS - 1 - bucket;
+    return -((int64_t)1 << (offset - 1));
+}
+
+void LatencyHistogram::record(int64_t duration)
+{
+    buckets[bucketOf(duration)]++;
+
+    if (count == 0 || duration < min)
+    {
+        min = duration;
+    }
+    if (count == 0 || duration > max)
+    {
+        max = duration;
+    }
+
+    count++;
+    sum += duration;
+}
+
+int64_t LatencyHistogram::getPercentile(double percentile) const
+{
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    uint64_t rank = std::max<uint64_t>(1, (uint64_t)(count * percentile / 100.0 + 0.5));
+    uint64_t seen = 0;
+
+    for (size_t i = 0; i < LATENCY_HISTOGRAM_BUCKETS; i++)
+    {
+        seen += buckets[i];
+        if (seen >= rank)
+        {
+            return std::clamp(upperOf(i), min, max);
+        }
+    }
+
+    return max;
+}
+
+uint64_t LatencyHistogram::getCount() const
+{
+    return count;
+}
+
+int64_t LatencyHistogram::getMean() const
+{
+    return count == 0 ? 0 : sum / (int64_t)count;
+}
+
+int64_t LatencyHistogram::getMin() const
+{
+    return min;
+}
+
+int64_t LatencyHistogram::getMax() const
+{
+    return max;
+}
+
+uint64_t LatencyHistogram::getBucket(size_t bucket) const
+{
+    return bucket < LATENCY_HISTOGRAM_BUCKETS ? buckets[bucket] : 0;
+}
+
+void LatencyTracker::recordProcessing(int64_t received, int64_t applied)
+{
+    processing.record(applied - received);
+}
+
+void LatencyTracker::recordTransit(uint64_t timestamp, int64_t received)
+{
+    if (timestamp == 0)
+    {
+        return;
+    }
+
+    int64_t duration = received - (int64_t)timestamp * 1000;
+    transit.record(duration);
+
+    if (transit.getCount() == 1)
+    {
+        windowStart = received;
+        windowMin = duration;
+    }
+    else if (received - windowStart >= CLOCK_SKEW_WINDOW_US)
+    {
+        // The previous window is kept so the estimate doesn't jump each time a window starts
+        previousMin = windowMin;
+        hasPrevious = true;
+        windowStart = received;
+        windowMin = duration;
+    }
+    else
+    {
+        windowMin = std::min(windowMin, duration);
+    }
+}
+
+int64_t LatencyTracker::now()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+const LatencyHistogram &LatencyTracker::getTransit() const
+{
+    return transit;
+}
+
+const LatencyHistogram &LatencyTracker::getProcessing() const
+{
+    return processing;
+}
+
+int64_t LatencyTracker::getClockSkew() const
+{
+    return hasPrevious ? std::min(windowMin, previousMin) : windowMin;
+}
+
+bool LatencyTracker::hasChanges() const
+{
+    return processing.getCount() != appended;
+}
+
+/**
+ * @brief Appends an Int64 Metric to a payload
+ *
+ */
+static void appendMetric(tahu::Payload *payload, const char *name, int64_t value, uint64_t timestamp)
+{
+    tahu::Metric metric;
+    memset(&metric, 0, sizeof(tahu::Metric));
+
+    metric.name = strdup(name);
+    metric.has_datatype = true;
+    metric.datatype = METRIC_DATA_TYPE_INT64;
+    metric.has_timestamp = true;
+    metric.timestamp = timestamp;
+    metric.which_value = org_eclipse_tahu_protobuf_Payload_Metric_long_value_tag;
+    metric.value.long_value = value;
+
+    add_metric_to_payload(payload, &metric);
+}
+
+void LatencyTracker::appendTo(tahu::Payload *payload, uint64_t timestamp)
+{
+    appended = processing.getCount();
+
+    appendMetric(payload, "Latency/Transit/Mean", transit.getMean(), timestamp);
+    appendMetric(payload, "Latency/Transit/P50", transit.getPercentile(50), timestamp);
+    appendMetric(payload, "Latency/Transit/P99", transit.getPercentile(99), timestamp);
+    appendMetric(payload, "Latency/Transit/Max", transit.getMax(), timestamp);
+    appendMetric(payload, "Latency/Processing/Mean", processing.getMean(), timestamp);
+    appendMetric(payload, "Latency/Processing/P50", processing.getPercentile(50), timestamp);
+    appendMetric(payload, "Latency/Processing/P99", processing.getPercentile(99), timestamp);
+    appendMetric(payload, "Latency/Processing/Max", processing.getMax(), timestamp);
+    appendMetric(payload, "Latency/Clock Skew", getClockSkew(), timestamp);
+    appendMetric(payload, "Latency/Messages", processing.getCount(), timestamp);
+}
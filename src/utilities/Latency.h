@@ -0,0 +1,164 @@
+/*
+ * File: Latency.h
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#ifndef SRC_UTILITIES_LATENCY
+#define SRC_UTILITIES_LATENCY
+
+#include "../types/TahuTypes.h"
+#include <cstdint>
+
+#define LATENCY_BUCKETS 40
+#define LATENCY_HISTOGRAM_BUCKETS (2 * LATENCY_BUCKETS - 1)
+#define CLOCK_SKEW_WINDOW_US 60000000
+
+/**
+ * @brief A histogram of signed durations in microseconds, with buckets growing in powers of two away from zero.
+ * The middle bucket, LATENCY_BUCKETS - 1, holds durations under 1us in magnitude. The buckets m above it hold
+ * [2^(m-1), 2^m) and the buckets m below it hold the same magnitudes for negative durations, so transit times of
+ * a Node whose clock is ahead of the host still have meaningful percentiles.
+ *
+ */
+class LatencyHistogram
+{
+private:
+    uint64_t buckets[LATENCY_HISTOGRAM_BUCKETS] = {};
+    uint64_t count = 0;
+    int64_t sum = 0;
+    int64_t min = 0;
+    int64_t max = 0;
+
+public:
+    /**
+     * @brief Adds a duration to the histogram
+     *
+     * @param duration The duration in microseconds
+     */
+    void record(int64_t duration);
+    /**
+     * @brief Estimates a percentile from the bucket it falls in
+     *
+     * @param percentile Between 0 and 100
+     * @return int64_t The bound of the bucket closest to positive infinity in microseconds, clamped to the
+     * durations recorded
+     */
+    int64_t getPercentile(double percentile) const;
+    uint64_t getCount() const;
+    /**
+     * @brief Gets the mean duration in microseconds
+     *
+     * @return int64_t
+     */
+    int64_t getMean() const;
+    int64_t getMin() const;
+    int64_t getMax() const;
+    /**
+     * @brief Gets the number of durations in a bucket
+     *
+     * @param bucket Between 0 and LATENCY_HISTOGRAM_BUCKETS, negative durations are below LATENCY_BUCKETS - 1
+     * @return uint64_t
+     */
+    uint64_t getBucket(size_t bucket) const;
+};
+
+/**
+ * @brief The latencies of the messages from a Node.
+ * Transit is the time from the payload's timestamp until the host received the message,
+ * and processing is the time from receiving the message until it was applied to the model.
+ *
+ */
+class LatencyTracker
+{
+private:
+    LatencyHistogram transit;
+    LatencyHistogram processing;
+    /**
+     * @brief The lowest transit time of the current and previous windows
+     *
+     */
+    int64_t windowMin = 0;
+    int64_t previousMin = 0;
+    bool hasPrevious = false;
+    int64_t windowStart = 0;
+    /**
+     * @brief The number of messages recorded when the latencies were last appended to a payload
+     *
+     */
+    uint64_t appended = 0;
+
+public:
+    /**
+     * @brief Records the transit time of a message as it's received
+     *
+     * @param timestamp The timestamp of the payload in milliseconds since the epoch, 0 if it had none
+     * @param received When the message was received in microseconds since the epoch
+     */
+    void recordTransit(uint64_t timestamp, int64_t received);
+    /**
+     * @brief Records the processing time of a message once it's applied to the model,
+     * which includes any time it was deferred by the Node's rate limit
+     *
+     * @param received When the message was received in microseconds since the epoch
+     * @param applied When the message was applied in microseconds since the epoch
+     */
+    void recordProcessing(int64_t received, int64_t applied);
+    /**
+     * @brief Gets the current time in microseconds since the epoch
+     *
+     * @return int64_t
+     */
+    static int64_t now();
+    const LatencyHistogram &getTransit() const;
+    const LatencyHistogram &getProcessing() const;
+    /**
+     * @brief Estimates how far the Node's clock is behind the host's clock, as the lowest transit time
+     * seen in the last one to two windows of CLOCK_SKEW_WINDOW_US. Negative if the Node's clock is ahead.
+     * The estimate includes the shortest network delay, as the two can't be told apart.
+     *
+     * @return int64_t The skew in microseconds
+     */
+    int64_t getClockSkew() const;
+    /**
+     * @brief Whether messages were recorded since the latencies were last appended to a payload
+     *
+     * @return true
+     * @return false
+     */
+    bool hasChanges() const;
+    /**
+     * @brief Appends the latencies as Int64 Metrics in microseconds under a Latency/ folder
+     *
+     * @param payload
+     * @param timestamp The timestamp of the Metrics in milliseconds since the epoch
+     */
+    void appendTo(tahu::Payload *payload, uint64_t timestamp);
+};
+
+#endif /* SRC_UTILITIES_LATENCY */
@@ -0,0 +1,348 @@
+/*
+ * File: MetricFilters.cpp
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#include "MetricFilters.h"
+
+using namespace std;
+
+#define PATH_SEGMENTS 4
+
+uint32_t StringInterner::intern(const string &value)
+{
+    auto item = ids.find(value);
+    if (item != ids.end())
+    {
+        return item->second;
+    }
+
+    uint32_t id = ids.size();
+    ids[value] = id;
+    return id;
+}
+
+bool StringInterner::find(const string &value, uint32_t &id) const
+{
+    auto item = ids.find(value);
+    if (item == ids.end())
+    {
+        return false;
+    }
+    id = item->second;
+    return true;
+}
+
+void StringInterner::clear()
+{
+    ids.clear();
+}
+
+/**
+ * @brief Splits a path into its group, node, device and metric segments.
+ * The metric segment is the remainder of the path.
+ *
+ */
+static size_t split(const string &path, string segments[PATH_SEGMENTS])
+{
+    size_t start = 0;
+    size_t count = 0;
+
+    while (count < PATH_SEGMENTS - 1)
+    {
+        auto index = path.find('/', start);
+        if (index == string::npos)
+        {
+            break;
+        }
+        segments[count++] = path.substr(start, index - start);
+        start = index + 1;
+    }
+
+    segments[count++] = path.substr(start);
+    return count;
+}
+
+static inline bool isGlob(const string &segment)
+{
+    return segment.find_first_of("*?") != string::npos;
+}
+
+MetricFilters::MetricFilters()
+{
+    compile();
+}
+
+int MetricFilters::add(const string &pattern, const set<uint32_t> &datatypes)
+{
+    for (int i = 0; i < MAX_METRIC_FILTERS; i++)
+    {
+        if (!filters[i].active)
+        {
+            filters[i].active = true;
+            filters[i].pattern = pattern;
+            filters[i].datatypes = datatypes;
+            active |= (uint64_t)1 << i;
+            compile();
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+void MetricFilters::remove(int subscriber)
+{
+    if (subscriber < 0 || subscriber >= MAX_METRIC_FILTERS || !filters[subscriber].active)
+    {
+        return;
+    }
+
+    filters[subscriber] = Filter();
+    active &= ~((uint64_t)1 << subscriber);
+    compile();
+}
+
+bool MetricFilters::empty() const
+{
+    return active == 0;
+}
+
+void MetricFilters::compile()
+{
+    root.reset(new FilterNode());
+    segments.clear();
+
+    anyDatatype = 0;
+
+    for (size_t datatype = 0; datatype < MAX_FILTER_DATATYPES; datatype++)
+    {
+        datatypeMasks[datatype] = 0;
+    }
+
+    for (int i = 0; i < MAX_METRIC_FILTERS; i++)
+    {
+        if (!filters[i].active)
+        {
+            continue;
+        }
+
+        uint64_t subscriber = (uint64_t)1 << i;
+
+        insert(filters[i].pattern, subscriber);
+
+        if (filters[i].datatypes.empty())
+        {
+            anyDatatype |= subscriber;
+        }
+
+        for (size_t datatype = 0; datatype < MAX_FILTER_DATATYPES; datatype++)
+        {
+            if (filters[i].datatypes.empty() || filters[i].datatypes.contains(datatype))
+            {
+                datatypeMasks[datatype] |= subscriber;
+            }
+        }
+    }
+}
+
+void MetricFilters::insert(const string &pattern, uint64_t subscriber)
+{
+    string parts[PATH_SEGMENTS];
+    size_t count = split(pattern, parts);
+    FilterNode *node = root.get();
+
+    for (size_t i = 0; i < count; i++)
+    {
+        string &part = parts[i];
+
+        if (part == "#")
+        {
+            node->remaining |= subscriber;
+            return;
+        }
+
+        if (part == "+")
+        {
+            if (!node->single)
+            {
+                node->single.reset(new FilterNode());
+            }
+            node = node->single.get();
+        }
+        else if (isGlob(part))
+        {
+            auto existing = find_if(
+                node->globs.begin(),
+                node->globs.end(),
+                [&part](const pair<string, unique_ptr<FilterNode>> &glob)
+                { return glob.first == part; });
+
+            if (existing == node->globs.end())
+            {
+                node->globs.emplace_back(part, make_unique<FilterNode>());
+                node = node->globs.back().second.get();
+            }
+            else
+            {
+                node = existing->second.get();
+            }
+        }
+        else
+        {
+            auto &child = node->literals[segments.intern(part)];
+            if (!child)
+            {
+                child.reset(new FilterNode());
+            }
+            node = child.get();
+        }
+    }
+
+    if (count == PATH_SEGMENTS)
+    {
+        node->subscribers |= subscriber;
+    }
+}
+
+uint64_t MetricFilters::match(FilterNode *node, const string *path[], size_t depth, size_t count) const
+{
+    uint64_t mask = node->remaining;
+
+    if (depth == count)
+    {
+        return mask | node->subscribers;
+    }
+
+    const string &segment = *path[depth];
+    uint32_t id;
+
+    if (!node->literals.empty() && segments.find(segment, id))
+    {
+        auto child = node->literals.find(id);
+        if (child != node->literals.end())
+        {
+            mask |= match(child->second.get(), path, depth + 1, count);
+        }
+    }
+
+    for (auto &child : node->globs)
+    {
+        if (glob(child.first.c_str(), segment.c_str()))
+        {
+            mask |= match(child.second.get(), path, depth + 1, count);
+        }
+    }
+
+    if (node->single)
+    {
+        mask |= match(node->single.get(), path, depth + 1, count);
+    }
+
+    return mask;
+}
+
+uint64_t MetricFilters::match(const string &publisher, bool isDevice, const string &metric, uint32_t datatype) const
+{
+    if (active == 0)
+    {
+        return ALL_SUBSCRIBERS;
+    }
+
+    // Splits the publisher into group, node and (optionally) device
+    string parts[PATH_SEGMENTS];
+    size_t count = 0;
+    size_t start = 0;
+
+    while (count < PATH_SEGMENTS - 2)
+    {
+        auto index = publisher.find('/', start);
+        if (index == string::npos)
+        {
+            break;
+        }
+        parts[count++] = publisher.substr(start, index - start);
+        start = index + 1;
+    }
+    parts[count++] = publisher.substr(start);
+
+    if (!isDevice)
+    {
+        parts[count++] = "";
+    }
+
+    if (count != PATH_SEGMENTS - 1)
+    {
+        return 0;
+    }
+
+    const string *path[PATH_SEGMENTS] = {&parts[0], &parts[1], &parts[2], &metric};
+
+    uint64_t mask = match(root.get(), path, 0, PATH_SEGMENTS);
+
+    mask &= datatype < MAX_FILTER_DATATYPES ? datatypeMasks[datatype] : anyDatatype;
+
+    return mask & active;
+}
+
+bool MetricFilters::glob(const char *pattern, const char *value)
+{
+    const char *retryPattern = nullptr;
+    const char *retryValue = nullptr;
+
+    while (*value)
+    {
+        if (*pattern == '*')
+        {
+            retryPattern = ++pattern;
+            retryValue = value;
+        }
+        else if (*pattern == '?' || *pattern == *value)
+        {
+            pattern++;
+            value++;
+        }
+        else if (retryPattern)
+        {
+            pattern = retryPattern;
+            value = ++retryValue;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    while (*pattern == '*')
+    {
+        pattern++;
+    }
+
+    return *pattern == '\0';
+}
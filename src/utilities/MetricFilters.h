@@ -0,0 +1,164 @@
+/*
+ * File: MetricFilters.h
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#ifndef SRC_UTILITIES_METRICFILTERS
+#define SRC_UTILITIES_METRICFILTERS
+
+#include <string>
+#include <vector>
+#include <set>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdint>
+
+#define MAX_METRIC_FILTERS 64
+// Datatypes with their own subscriber mask, larger datatypes only match filters without datatypes
+#define MAX_FILTER_DATATYPES 64
+#define ALL_SUBSCRIBERS (~(uint64_t)0)
+
+/**
+ * @brief Maps strings to small unique ids
+ *
+ */
+class StringInterner
+{
+private:
+    std::unordered_map<std::string, uint32_t> ids;
+
+public:
+    /**
+     * @brief Gets the id of a string, assigning a new id if it has none
+     *
+     * @param value
+     * @return uint32_t
+     */
+    uint32_t intern(const std::string &value);
+    /**
+     * @brief Finds the id of a string without assigning one
+     *
+     * @param value
+     * @param id Filled with the id if the string has one
+     * @return true
+     * @return false The string has no id
+     */
+    bool find(const std::string &value, uint32_t &id) const;
+    /**
+     * @brief Removes all strings
+     *
+     */
+    void clear();
+};
+
+/**
+ * @brief A set of Metric filters compiled into a trie over interned path segments.
+ * Each filter is assigned a subscriber id, and matching a Metric returns a bitmask of the subscribers it matches.
+ *
+ * Filters are in the form group/node/device/metric where each of the first three segments is
+ * either a name, a '+' matching any single name, or a name with '*' and '?' wildcards.
+ * Node Metrics have an empty device segment. The metric segment is the remainder of the filter and
+ * may contain '/' along with wildcards. A '#' segment matches everything beneath it.
+ *
+ * e.g. group/+/+/Inputs/Temperature* or group/node//#
+ *
+ */
+class MetricFilters
+{
+private:
+    struct FilterNode
+    {
+        std::map<uint32_t, std::unique_ptr<FilterNode>> literals;
+        std::vector<std::pair<std::string, std::unique_ptr<FilterNode>>> globs;
+        std::unique_ptr<FilterNode> single;
+        uint64_t remaining = 0;
+        uint64_t subscribers = 0;
+    };
+
+    struct Filter
+    {
+        bool active = false;
+        std::string pattern;
+        std::set<uint32_t> datatypes;
+    };
+
+    Filter filters[MAX_METRIC_FILTERS];
+    uint64_t active = 0;
+    uint64_t datatypeMasks[MAX_FILTER_DATATYPES];
+    uint64_t anyDatatype = 0;
+    std::unique_ptr<FilterNode> root;
+    StringInterner segments;
+
+    /**
+     * @brief Rebuilds the trie and datatype masks from the active filters
+     *
+     */
+    void compile();
+    void insert(const std::string &pattern, uint64_t subscriber);
+    uint64_t match(FilterNode *node, const std::string *path[], size_t depth, size_t count) const;
+    static bool glob(const char *pattern, const char *value);
+
+public:
+    MetricFilters();
+    /**
+     * @brief Registers a filter
+     *
+     * @param pattern The path pattern of the filter
+     * @param datatypes The Metric datatypes the filter matches. Matches all datatypes if empty.
+     * @return int The subscriber id of the filter, or -1 if no more filters can be registered
+     */
+    int add(const std::string &pattern, const std::set<uint32_t> &datatypes = {});
+    /**
+     * @brief Removes a filter
+     *
+     * @param subscriber The subscriber id of the filter
+     */
+    void remove(int subscriber);
+    /**
+     * @brief Whether any filters are registered
+     *
+     * @return true
+     * @return false
+     */
+    bool empty() const;
+    /**
+     * @brief Matches a Metric against all filters
+     *
+     * @param publisher The name of the Node (group/node) or Device (group/node/device) the Metric belongs to
+     * @param isDevice Whether the publisher is a Device
+     * @param metric The name of the Metric
+     * @param datatype The datatype of the Metric
+     * @return uint64_t A bitmask of the subscribers that match the Metric. All subscribers if there are no filters.
+     */
+    uint64_t match(const std::string &publisher, bool isDevice, const std::string &metric, uint32_t datatype) const;
+};
+
+#endif /* SRC_UTILITIES_METRICFILTERS */
@@ -0,0 +1,138 @@
+/*
+ * File: ObjectPool.h
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#ifndef SRC_UTILITIES_OBJECTPOOL
+#define SRC_UTILITIES_OBJECTPOOL
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+#define OBJECT_POOL_CHUNK 256
+
+/**
+ * @brief Allocates objects of one type from contiguous chunks, recycling the slots of destroyed objects.
+ * All chunks are released at once when the pool is destroyed, every object must be destroyed before then.
+ *
+ * @tparam T
+ */
+template <typename T>
+class ObjectPool
+{
+private:
+    union Slot
+    {
+        Slot *next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    std::vector<std::unique_ptr<Slot[]>> chunks;
+    Slot *available = nullptr;
+    size_t used = 0;
+
+    void grow()
+    {
+        Slot *chunk = new Slot[OBJECT_POOL_CHUNK];
+        chunks.emplace_back(chunk);
+
+        for (size_t i = 0; i < OBJECT_POOL_CHUNK; i++)
+        {
+            chunk[i].next = available;
+            available = &chunk[i];
+        }
+    }
+
+public:
+    ObjectPool() = default;
+    ObjectPool(const ObjectPool &) = delete;
+    ObjectPool &operator=(const ObjectPool &) = delete;
+
+    /**
+     * @brief Constructs an object in a free slot, allocating a new chunk if there are none
+     *
+     * @tparam Args
+     * @param args The arguments passed to the constructor of the object
+     * @return T*
+     */
+    template <typename... Args>
+    T *create(Args &&...args)
+    {
+        if (!available)
+        {
+            grow();
+        }
+
+        Slot *slot = available;
+        available = slot->next;
+        used++;
+
+        return new (slot->storage) T(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Destroys an object created by this pool, keeping its slot for the next object
+     *
+     * @param item
+     */
+    void destroy(T *item)
+    {
+        item->~T();
+
+        Slot *slot = reinterpret_cast<Slot *>(item);
+        slot->next = available;
+        available = slot;
+        used--;
+    }
+
+    /**
+     * @brief Gets the number of objects in use
+     *
+     * @return size_t
+     */
+    size_t size() const
+    {
+        return used;
+    }
+
+    /**
+     * @brief Gets the number of objects the allocated chunks can hold
+     *
+     * @return size_t
+     */
+    size_t capacity() const
+    {
+        return chunks.size() * OBJECT_POOL_CHUNK;
+    }
+};
+
+#endif /* SRC_UTILITIES_OBJECTPOOL */
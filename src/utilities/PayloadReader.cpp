@@ -0,0 +1,272 @@
+/*
+ * File: PayloadReader.cpp
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#include "PayloadReader.h"
+#include "pb_decode.h"
+
+#define FNV_OFFSET 14695981039346656037ULL
+#define FNV_PRIME 1099511628211ULL
+
+/**
+ * @brief Current position of a buffer stream.
+ * The state of a nanopb buffer stream is a pointer to the next unread byte.
+ *
+ */
+static inline const uint8_t *position(pb_istream_t *stream)
+{
+    return (const uint8_t *)stream->state;
+}
+
+static inline uint64_t hash(uint64_t digest, const uint8_t *start, const uint8_t *end)
+{
+    while (start < end)
+    {
+        digest = (digest ^ *start++) * FNV_PRIME;
+    }
+    return digest;
+}
+
+/**
+ * @brief Skips any unread bytes of a substream and returns to the parent stream
+ *
+ */
+static inline bool closeSubstream(pb_istream_t *stream, pb_istream_t *substream)
+{
+    if (substream->bytes_left > 0 && !pb_read(substream, NULL, substream->bytes_left))
+    {
+        return false;
+    }
+    pb_close_string_substream(stream, substream);
+    return true;
+}
+
+PayloadReader::PayloadReader(const uint8_t *buffer, size_t length) : buffer(buffer), length(length)
+{
+}
+
+bool PayloadReader::header(tahu::Payload *payload)
+{
+    pb_istream_t stream = pb_istream_from_buffer(buffer, length);
+    pb_wire_type_t wireType;
+    uint32_t tag;
+    bool eof = false;
+
+    while (pb_decode_tag(&stream, &wireType, &tag, &eof))
+    {
+        if (tag == org_eclipse_tahu_protobuf_Payload_timestamp_tag && wireType == PB_WT_VARINT)
+        {
+            payload->has_timestamp = true;
+            if (!pb_decode_varint(&stream, &payload->timestamp))
+            {
+                return false;
+            }
+        }
+        else if (tag == org_eclipse_tahu_protobuf_Payload_seq_tag && wireType == PB_WT_VARINT)
+        {
+            payload->has_seq = true;
+            if (!pb_decode_varint(&stream, &payload->seq))
+            {
+                return false;
+            }
+        }
+        else if (!pb_skip_field(&stream, wireType))
+        {
+            return false;
+        }
+    }
+
+    return eof;
+}
+
+size_t PayloadReader::count()
+{
+    if (indexed)
+    {
+        return metrics.size();
+    }
+
+    pb_istream_t stream = pb_istream_from_buffer(buffer, length);
+    pb_wire_type_t wireType;
+    uint32_t tag;
+    bool eof = false;
+    size_t counted = 0;
+
+    while (pb_decode_tag(&stream, &wireType, &tag, &eof))
+    {
+        if (tag == org_eclipse_tahu_protobuf_Payload_metrics_tag)
+        {
+            counted++;
+        }
+
+        if (!pb_skip_field(&stream, wireType))
+        {
+            break;
+        }
+    }
+
+    return counted;
+}
+
+bool PayloadReader::readHeader(pb_istream_t *stream, MetricHeader &header)
+{
+    pb_wire_type_t wireType;
+    uint32_t tag;
+    bool eof = false;
+
+    header.digest = FNV_OFFSET;
+
+    while (pb_decode_tag(stream, &wireType, &tag, &eof))
+    {
+        if (tag == org_eclipse_tahu_protobuf_Payload_Metric_name_tag && wireType == PB_WT_STRING)
+        {
+            pb_istream_t substream;
+            if (!pb_make_string_substream(stream, &substream))
+            {
+                return false;
+            }
+            header.name.resize(substream.bytes_left);
+            if (!pb_read(&substream, (uint8_t *)header.name.data(), substream.bytes_left))
+            {
+                return false;
+            }
+            pb_close_string_substream(stream, &substream);
+        }
+        else if (tag == org_eclipse_tahu_protobuf_Payload_Metric_alias_tag && wireType == PB_WT_VARINT)
+        {
+            header.hasAlias = true;
+            if (!pb_decode_varint(stream, &header.alias))
+            {
+                return false;
+            }
+        }
+        else if (tag == org_eclipse_tahu_protobuf_Payload_Metric_timestamp_tag && wireType == PB_WT_VARINT)
+        {
+            header.hasTimestamp = true;
+            if (!pb_decode_varint(stream, &header.timestamp))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            const uint8_t *start = position(stream);
+            if (!pb_skip_field(stream, wireType))
+            {
+                return false;
+            }
+            header.digest = (header.digest ^ tag) * FNV_PRIME;
+            header.digest = hash(header.digest, start, position(stream));
+        }
+    }
+
+    return eof;
+}
+
+bool PayloadReader::index()
+{
+    if (indexed)
+    {
+        return valid;
+    }
+
+    indexed = true;
+    metrics.reserve(count());
+
+    pb_istream_t stream = pb_istream_from_buffer(buffer, length);
+    pb_wire_type_t wireType;
+    uint32_t tag;
+    bool eof = false;
+
+    while (pb_decode_tag(&stream, &wireType, &tag, &eof))
+    {
+        if (tag != org_eclipse_tahu_protobuf_Payload_metrics_tag || wireType != PB_WT_STRING)
+        {
+            if (!pb_skip_field(&stream, wireType))
+            {
+                return false;
+            }
+            continue;
+        }
+
+        pb_istream_t substream;
+        if (!pb_make_string_substream(&stream, &substream))
+        {
+            return false;
+        }
+
+        metrics.emplace_back();
+        EncodedMetric &metric = metrics.back();
+        metric.offset = position(&substream) - buffer;
+        metric.size = substream.bytes_left;
+
+        if (!readHeader(&substream, metric.header) || !closeSubstream(&stream, &substream))
+        {
+            metrics.pop_back();
+            return false;
+        }
+    }
+
+    valid = eof;
+    return valid;
+}
+
+bool PayloadReader::each(std::function<bool(MetricHeader &)> select, std::function<bool(tahu::Metric *, MetricHeader &)> apply)
+{
+    bool complete = index();
+
+    // Metrics read before a malformed one are still applied, as they were when the Payload was walked in order
+    for (auto &encoded : metrics)
+    {
+        if (!select(encoded.header))
+        {
+            continue;
+        }
+
+        pb_istream_t stream = pb_istream_from_buffer(buffer + encoded.offset, encoded.size);
+        tahu::Metric metric = org_eclipse_tahu_protobuf_Payload_Metric_init_zero;
+
+        if (!pb_decode(&stream, org_eclipse_tahu_protobuf_Payload_Metric_fields, &metric))
+        {
+            pb_release(org_eclipse_tahu_protobuf_Payload_Metric_fields, &metric);
+            return false;
+        }
+
+        bool proceed = apply(&metric, encoded.header);
+        pb_release(org_eclipse_tahu_protobuf_Payload_Metric_fields, &metric);
+
+        if (!proceed)
+        {
+            return true;
+        }
+    }
+
+    return complete;
+}
@@ -0,0 +1,140 @@
+/*
+ * File: PayloadReader.h
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#ifndef SRC_UTILITIES_PAYLOADREADER
+#define SRC_UTILITIES_PAYLOADREADER
+
+#include "../types/TahuTypes.h"
+#include <string>
+#include <vector>
+#include <functional>
+
+/**
+ * @brief The identifying fields of an encoded Metric, read without decoding the Metric
+ *
+ */
+struct MetricHeader
+{
+    std::string name;
+    bool hasAlias = false;
+    uint64_t alias = 0;
+    bool hasTimestamp = false;
+    uint64_t timestamp = 0;
+    /**
+     * @brief A 64 bit FNV-1a hash of the encoded datatype, flags, metadata, properties and value of the Metric.
+     * Republished Metrics with the same digest are skipped without being decoded, a change that collides with
+     * the previous value is missed until the next change. Collisions are unlikely enough to accept for the decoding saved.
+     *
+     */
+    uint64_t digest = 0;
+};
+
+/**
+ * @brief The header of an encoded Metric and where the Metric is in the Payload
+ *
+ */
+struct EncodedMetric
+{
+    MetricHeader header;
+    size_t offset = 0;
+    size_t size = 0;
+};
+
+/**
+ * @brief Reads an encoded Sparkplug Payload in place, one Metric at a time.
+ * Avoids decoding the complete Payload, allowing Metrics to be skipped without being decoded.
+ *
+ */
+class PayloadReader
+{
+private:
+    const uint8_t *buffer;
+    size_t length;
+    std::vector<EncodedMetric> metrics;
+    bool indexed = false;
+    bool valid = false;
+
+    /**
+     * @brief Reads the header of an encoded Metric
+     *
+     * @param stream A stream over the encoded Metric
+     * @param header The header to fill
+     * @return true
+     * @return false The Metric is malformed
+     */
+    bool readHeader(pb_istream_t *stream, MetricHeader &header);
+
+protected:
+public:
+    /**
+     * @brief Construct a new Payload Reader over an encoded Payload.
+     * The buffer must outlive the reader.
+     *
+     * @param buffer
+     * @param length
+     */
+    PayloadReader(const uint8_t *buffer, size_t length);
+    /**
+     * @brief Decodes the top level fields of the Payload, leaving the Metrics encoded
+     *
+     * @param payload The Payload to fill
+     * @return true
+     * @return false The Payload is malformed
+     */
+    bool header(tahu::Payload *payload);
+    /**
+     * @brief Counts the Metrics of the Payload without reading them
+     *
+     * @return size_t
+     */
+    size_t count();
+    /**
+     * @brief Reads the header of every Metric in a single walk of the Payload.
+     * Called by the decode pool so only the selected Metrics are left to decode when the Payload is applied.
+     *
+     * @return true
+     * @return false The Payload is malformed
+     */
+    bool index();
+    /**
+     * @brief Walks each Metric of the Payload, indexing the Payload first if it wasn't already.
+     * Metrics are only decoded if select returns true for their header.
+     * Decoded Metrics are released after apply returns.
+     *
+     * @param select Whether the Metric should be decoded
+     * @param apply Called with each decoded Metric. Returning false stops the walk.
+     * @return true
+     * @return false The Payload is malformed
+     */
+    bool each(std::function<bool(MetricHeader &)> select, std::function<bool(tahu::Metric *, MetricHeader &)> apply);
+};
+
+#endif /* SRC_UTILITIES_PAYLOADREADER */
@@ -0,0 +1,117 @@
+/*
+ * File: RateLimiter.cpp
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#include "RateLimiter.h"
+#include <algorithm>
+
+void RateLimiter::refill(int64_t now)
+{
+    double seconds = (now - last) / 1000000.0;
+    last = now;
+
+    if (seconds <= 0)
+    {
+        return;
+    }
+
+    // Limits below one per second still fill to the single token a message requires
+    if (limit.messages > 0)
+    {
+        messageTokens = std::min(std::max(1.0, limit.messages), messageTokens + seconds * limit.messages);
+    }
+    if (limit.metrics > 0)
+    {
+        metricTokens = std::min(std::max(1.0, limit.metrics), metricTokens + seconds * limit.metrics);
+    }
+}
+
+void RateLimiter::configure(const RateLimit &limit, int64_t now)
+{
+    this->limit = limit;
+    messageTokens = std::max(1.0, limit.messages);
+    metricTokens = std::max(1.0, limit.metrics);
+    last = now;
+}
+
+const RateLimit &RateLimiter::getLimit() const
+{
+    return limit;
+}
+
+bool RateLimiter::isLimited() const
+{
+    return limit.messages > 0 || limit.metrics > 0;
+}
+
+bool RateLimiter::countsMetrics() const
+{
+    return limit.metrics > 0;
+}
+
+bool RateLimiter::ready(int64_t now, size_t messages, size_t metrics)
+{
+    refill(now);
+
+    // Buckets never hold more than a burst, so larger requests wait for full buckets
+    double requiredMessages = std::min((double)messages, std::max(1.0, limit.messages));
+    double requiredMetrics = std::min((double)metrics, std::max(1.0, limit.metrics));
+
+    return (limit.messages <= 0 || messageTokens >= requiredMessages) &&
+           (limit.metrics <= 0 || (metricTokens > 0 && metricTokens >= requiredMetrics));
+}
+
+void RateLimiter::charge(size_t messages, size_t metrics)
+{
+    if (limit.messages > 0)
+    {
+        messageTokens -= messages;
+    }
+    if (limit.metrics > 0)
+    {
+        metricTokens -= metrics;
+    }
+}
+
+bool RateLimiter::admit(size_t metrics, int64_t now)
+{
+    if (!isLimited())
+    {
+        return true;
+    }
+
+    if (!ready(now, 1, metrics))
+    {
+        return false;
+    }
+
+    charge(1, metrics);
+    return true;
+}
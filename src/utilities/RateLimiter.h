@@ -0,0 +1,156 @@
+/*
+ * File: RateLimiter.h
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#ifndef SRC_UTILITIES_RATELIMITER
+#define SRC_UTILITIES_RATELIMITER
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief What happens to data messages received over a Node's rate limit.
+ * Births, deaths and commands are never limited.
+ *
+ */
+enum class LimitPolicy : uint8_t
+{
+    /**
+     * @brief The messages are discarded
+     *
+     */
+    DROP,
+    /**
+     * @brief The messages are held and applied together once the Node is under its limit,
+     * only the last value of each Metric is applied
+     *
+     */
+    COALESCE,
+    /**
+     * @brief The messages are held and applied in order as the Node's limit allows
+     *
+     */
+    DEFER
+};
+
+/**
+ * @brief The rate a Node and its Devices can send data at.
+ * Nodes can burst up to one second of their rate.
+ *
+ */
+struct RateLimit
+{
+    /**
+     * @brief Data messages per second, 0 for no limit
+     *
+     */
+    double messages = 0;
+    /**
+     * @brief Metrics per second within data messages, 0 for no limit
+     *
+     */
+    double metrics = 0;
+    LimitPolicy policy = LimitPolicy::DROP;
+};
+
+/**
+ * @brief Token buckets for the messages and Metrics of a Node.
+ * A message is admitted once there are tokens for it and its Metrics. Messages larger than the burst
+ * only need full buckets, and overdraw them so they're still admitted once the buckets refill.
+ * Buckets hold one second of tokens, and at least one token so limits below one per second still admit messages.
+ *
+ */
+class RateLimiter
+{
+private:
+    RateLimit limit;
+    double messageTokens = 0;
+    double metricTokens = 0;
+    int64_t last = 0;
+
+    /**
+     * @brief Adds the tokens earned since the last refill
+     *
+     * @param now The current time in microseconds
+     */
+    void refill(int64_t now);
+
+public:
+    /**
+     * @brief Sets the limit, starting with a full burst
+     *
+     * @param limit
+     * @param now The current time in microseconds
+     */
+    void configure(const RateLimit &limit, int64_t now);
+    const RateLimit &getLimit() const;
+    /**
+     * @brief Whether either rate is limited
+     *
+     * @return true
+     * @return false
+     */
+    bool isLimited() const;
+    /**
+     * @brief Whether a Metric count is needed to admit messages
+     *
+     * @return true
+     * @return false
+     */
+    bool countsMetrics() const;
+    /**
+     * @brief Whether there are tokens for a number of messages and Metrics, or full buckets if they're larger than the burst
+     *
+     * @param now The current time in microseconds
+     * @param messages
+     * @param metrics
+     * @return true
+     * @return false
+     */
+    bool ready(int64_t now, size_t messages = 1, size_t metrics = 0);
+    /**
+     * @brief Takes the tokens for messages and Metrics, which may overdraw the buckets
+     *
+     * @param messages
+     * @param metrics
+     */
+    void charge(size_t messages, size_t metrics);
+    /**
+     * @brief Admits a message if there are tokens left, taking its tokens
+     *
+     * @param metrics The number of Metrics in the message
+     * @param now The current time in microseconds
+     * @return true
+     * @return false The message is over the limit
+     */
+    bool admit(size_t metrics, int64_t now);
+};
+
+#endif /* SRC_UTILITIES_RATELIMITER */
@@ -0,0 +1,161 @@
+/*
+ * File: SmallVector.h
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#ifndef SRC_UTILITIES_SMALLVECTOR
+#define SRC_UTILITIES_SMALLVECTOR
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * @brief A vector of trivially copyable items that stores the first few items inline,
+ * only allocating once it grows past its inline capacity
+ *
+ * @tparam T
+ * @tparam N The number of items stored inline
+ */
+template <typename T, size_t N>
+class SmallVector
+{
+    static_assert(std::is_trivially_copyable_v<T>, "SmallVector only stores trivially copyable items");
+
+private:
+    T *items = storage;
+    uint32_t count = 0;
+    uint32_t capacity = N;
+    T storage[N];
+
+    void reserve(uint32_t required)
+    {
+        if (required <= capacity)
+        {
+            return;
+        }
+
+        uint32_t grown = capacity * 2 > required ? capacity * 2 : required;
+        T *moved = (T *)malloc(sizeof(T) * grown);
+        memcpy(moved, items, sizeof(T) * count);
+
+        if (items != storage)
+        {
+            free(items);
+        }
+
+        items = moved;
+        capacity = grown;
+    }
+
+public:
+    SmallVector() = default;
+
+    SmallVector(const SmallVector &other)
+    {
+        reserve(other.count);
+        memcpy(items, other.items, sizeof(T) * other.count);
+        count = other.count;
+    }
+
+    SmallVector &operator=(const SmallVector &other)
+    {
+        if (this != &other)
+        {
+            count = 0;
+            reserve(other.count);
+            memcpy(items, other.items, sizeof(T) * other.count);
+            count = other.count;
+        }
+        return *this;
+    }
+
+    ~SmallVector()
+    {
+        if (items != storage)
+        {
+            free(items);
+        }
+    }
+
+    void push_back(const T &item)
+    {
+        reserve(count + 1);
+        items[count++] = item;
+    }
+
+    void clear()
+    {
+        count = 0;
+    }
+
+    size_t size() const
+    {
+        return count;
+    }
+
+    bool empty() const
+    {
+        return count == 0;
+    }
+
+    T &operator[](size_t index)
+    {
+        return items[index];
+    }
+
+    const T &operator[](size_t index) const
+    {
+        return items[index];
+    }
+
+    T *begin()
+    {
+        return items;
+    }
+
+    T *end()
+    {
+        return items + count;
+    }
+
+    const T *begin() const
+    {
+        return items;
+    }
+
+    const T *end() const
+    {
+        return items + count;
+    }
+};
+
+#endif /* SRC_UTILITIES_SMALLVECTOR */
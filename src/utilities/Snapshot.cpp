@@ -0,0 +1,228 @@
+/*
+ * File: Snapshot.cpp
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#include "Snapshot.h"
+#include <cstring>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define DEBUGGING 1
+#ifdef DEBUGGING
+#define LOGGER(format, ...) \
+    printf("Snapshot: ");   \
+    printf(format, ##__VA_ARGS__)
+#else
+#define LOGGER(out, ...)
+#endif
+
+using namespace std;
+
+#define HEADER_SIZE (3 * sizeof(uint32_t))
+#define COUNT_OFFSET (2 * sizeof(uint32_t))
+
+SnapshotWriter::SnapshotWriter()
+{
+    uint32_t magic = SNAPSHOT_MAGIC;
+    uint32_t version = SNAPSHOT_VERSION;
+    append(&magic, sizeof(magic));
+    append(&version, sizeof(version));
+    append(&count, sizeof(count));
+}
+
+void SnapshotWriter::append(const void *data, size_t length)
+{
+    const uint8_t *bytes = (const uint8_t *)data;
+    buffer.insert(buffer.end(), bytes, bytes + length);
+}
+
+bool SnapshotWriter::add(const string &name, tahu::Payload *payload)
+{
+    if (name.length() > UINT16_MAX)
+    {
+        return false;
+    }
+
+    // A null buffer sizes the payload without encoding it
+    ssize_t encodedLength = encode_payload(NULL, 0, payload);
+    if (encodedLength < 0)
+    {
+        return false;
+    }
+
+    uint16_t nameLength = name.length();
+    uint32_t payloadLength = encodedLength;
+
+    append(&nameLength, sizeof(nameLength));
+    append(name.data(), nameLength);
+    append(&payloadLength, sizeof(payloadLength));
+
+    size_t offset = buffer.size();
+    buffer.resize(offset + payloadLength);
+
+    if (encode_payload(buffer.data() + offset, payloadLength, payload) != encodedLength)
+    {
+        buffer.resize(offset - sizeof(payloadLength) - nameLength - sizeof(nameLength));
+        return false;
+    }
+
+    count++;
+    return true;
+}
+
+bool SnapshotWriter::write(const string &path)
+{
+    memcpy(buffer.data() + COUNT_OFFSET, &count, sizeof(count));
+
+    string temporary = path + ".tmp";
+    FILE *file = fopen(temporary.c_str(), "wb");
+
+    if (!file)
+    {
+        LOGGER("Failed to open %s.\n", temporary.c_str());
+        return false;
+    }
+
+    bool written = fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+    written = fflush(file) == 0 && written;
+    written = fsync(fileno(file)) == 0 && written;
+    fclose(file);
+
+    if (!written || rename(temporary.c_str(), path.c_str()) != 0)
+    {
+        LOGGER("Failed to write %s.\n", path.c_str());
+        remove(temporary.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+SnapshotReader::~SnapshotReader()
+{
+    if (data)
+    {
+        munmap(data, size);
+    }
+}
+
+bool SnapshotReader::open(const string &path)
+{
+    int file = ::open(path.c_str(), O_RDONLY);
+
+    if (file < 0)
+    {
+        return false;
+    }
+
+    struct stat status;
+
+    if (fstat(file, &status) != 0 || (size_t)status.st_size < HEADER_SIZE)
+    {
+        close(file);
+        return false;
+    }
+
+    size = status.st_size;
+    void *mapped = mmap(NULL, size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+
+    if (mapped == MAP_FAILED)
+    {
+        size = 0;
+        return false;
+    }
+
+    data = (uint8_t *)mapped;
+    madvise(data, size, MADV_SEQUENTIAL);
+
+    uint32_t magic, version;
+
+    if (!read(&magic, sizeof(magic)) || !read(&version, sizeof(version)) || !read(&remaining, sizeof(remaining)))
+    {
+        return false;
+    }
+
+    if (magic != SNAPSHOT_MAGIC || version != SNAPSHOT_VERSION)
+    {
+        LOGGER("%s is not a compatible snapshot.\n", path.c_str());
+        remaining = 0;
+        return false;
+    }
+
+    return true;
+}
+
+bool SnapshotReader::read(void *target, size_t length)
+{
+    if (size - position < length)
+    {
+        return false;
+    }
+
+    memcpy(target, data + position, length);
+    position += length;
+    return true;
+}
+
+bool SnapshotReader::next(SnapshotRecord &record)
+{
+    if (remaining == 0)
+    {
+        return false;
+    }
+
+    uint16_t nameLength;
+    uint32_t payloadLength;
+
+    if (!read(&nameLength, sizeof(nameLength)) || size - position < nameLength)
+    {
+        remaining = 0;
+        return false;
+    }
+
+    record.name.assign((const char *)data + position, nameLength);
+    position += nameLength;
+
+    if (!read(&payloadLength, sizeof(payloadLength)) || size - position < payloadLength)
+    {
+        remaining = 0;
+        return false;
+    }
+
+    record.payload = data + position;
+    record.length = payloadLength;
+    position += payloadLength;
+    remaining--;
+    return true;
+}
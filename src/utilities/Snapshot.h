@@ -0,0 +1,130 @@
+/*
+ * File: Snapshot.h
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#ifndef SRC_UTILITIES_SNAPSHOT
+#define SRC_UTILITIES_SNAPSHOT
+
+#include "../types/TahuTypes.h"
+#include <string>
+#include <vector>
+
+#define SNAPSHOT_MAGIC 0x53504853 // "SPHS"
+#define SNAPSHOT_VERSION 1
+
+/**
+ * @brief Writes a snapshot of the model to disk.
+ * A snapshot is a small header followed by one record per Node or Device, each record holding
+ * the name of the Publisher and its Metrics encoded as a Sparkplug Payload.
+ *
+ * Layout (host byte order):
+ *   header: uint32 magic, uint32 version, uint32 record count
+ *   record: uint16 name length, name, uint32 payload length, encoded payload
+ */
+class SnapshotWriter
+{
+private:
+    std::vector<uint8_t> buffer;
+    uint32_t count = 0;
+
+    void append(const void *data, size_t length);
+
+protected:
+public:
+    SnapshotWriter();
+    /**
+     * @brief Encodes and adds a Publisher to the snapshot
+     *
+     * @param name The name of the Node (group/node) or Device (group/node/device)
+     * @param payload
+     * @return true
+     * @return false The payload could not be encoded
+     */
+    bool add(const std::string &name, tahu::Payload *payload);
+    /**
+     * @brief Writes the snapshot to a file. The snapshot is written to a temporary file first
+     * and renamed, so an existing snapshot is never left partially written.
+     *
+     * @param path
+     * @return true
+     * @return false
+     */
+    bool write(const std::string &path);
+};
+
+/**
+ * @brief A Publisher read from a snapshot
+ *
+ */
+struct SnapshotRecord
+{
+    std::string name;
+    const uint8_t *payload = nullptr;
+    size_t length = 0;
+};
+
+/**
+ * @brief Reads a snapshot written by a SnapshotWriter.
+ * The file is memory mapped and records are read in place.
+ *
+ */
+class SnapshotReader
+{
+private:
+    uint8_t *data = nullptr;
+    size_t size = 0;
+    size_t position = 0;
+    uint32_t remaining = 0;
+
+    bool read(void *target, size_t length);
+
+protected:
+public:
+    SnapshotReader(){};
+    ~SnapshotReader();
+    /**
+     * @brief Maps a snapshot file and validates its header
+     *
+     * @param path
+     * @return true
+     * @return false The file doesn't exist or isn't a valid snapshot
+     */
+    bool open(const std::string &path);
+    /**
+     * @brief Reads the next record of the snapshot. The record's payload is only valid while the reader is open.
+     *
+     * @param record
+     * @return true
+     * @return false There are no more records or the snapshot is truncated
+     */
+    bool next(SnapshotRecord &record);
+};
+
+#endif /* SRC_UTILITIES_SNAPSHOT */
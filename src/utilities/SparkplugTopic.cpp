@@ -166,6 +166,33 @@ std::string &SparkplugTopic::getDevice()
     return device;
 }
 
+const std::string &SparkplugTopic::getCommandName(SparkplugCommandType type)
+{
+    static const string INVALID{""};
+
+    switch (type)
+    {
+    case SparkplugCommandType::NBIRTH:
+        return NBIRTH;
+    case SparkplugCommandType::NDEATH:
+        return NDEATH;
+    case SparkplugCommandType::NDATA:
+        return NDATA;
+    case SparkplugCommandType::NCMD:
+        return NCMD;
+    case SparkplugCommandType::DBIRTH:
+        return DBIRTH;
+    case SparkplugCommandType::DDEATH:
+        return DDEATH;
+    case SparkplugCommandType::DDATA:
+        return DDATA;
+    case SparkplugCommandType::DCMD:
+        return DCMD;
+    default:
+        return INVALID;
+    }
+}
+
 inline SparkplugCommandType SparkplugTopic::parseCommand(std::string &input)
 {
     if (DDATA.compare(input) == 0)
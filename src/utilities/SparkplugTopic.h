@@ -74,6 +74,13 @@ public:
     std::string &getGroup();
     std::string &getNode();
     std::string &getDevice();
+    /**
+     * @brief Gets the topic name of a command type (e.g. NBIRTH)
+     *
+     * @param type
+     * @return const std::string& The name, empty for an invalid type
+     */
+    static const std::string &getCommandName(SparkplugCommandType type);
 };
 
 #endif /* SRC_UTILITIES_SPARKPLUGTOPIC */
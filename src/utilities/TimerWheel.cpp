@@ -0,0 +1,160 @@
+/*
+ * File: TimerWheel.cpp
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#include "TimerWheel.h"
+
+#define TIMER_WHEEL_MASK (TIMER_WHEEL_SLOTS - 1)
+#define TIMER_WHEEL_RANGE ((uint64_t)1 << (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS))
+
+TimerWheel::TimerWheel()
+{
+    for (auto &level : slots)
+    {
+        for (auto &slot : level)
+        {
+            slot.previous = &slot;
+            slot.next = &slot;
+        }
+    }
+}
+
+void TimerWheel::insert(TimerEntry *entry)
+{
+    // A timer belongs to the innermost level whose slots all share the timer's expiry above that level
+    int level = 0;
+    while (level < TIMER_WHEEL_LEVELS - 1 &&
+           (entry->expiry >> ((level + 1) * TIMER_WHEEL_BITS)) != (now >> ((level + 1) * TIMER_WHEEL_BITS)))
+    {
+        level++;
+    }
+
+    TimerEntry *head = &slots[level][(entry->expiry >> (level * TIMER_WHEEL_BITS)) & TIMER_WHEEL_MASK];
+    entry->previous = head->previous;
+    entry->next = head;
+    head->previous->next = entry;
+    head->previous = entry;
+}
+
+void TimerWheel::unlink(TimerEntry *entry)
+{
+    entry->previous->next = entry->next;
+    entry->next->previous = entry->previous;
+    entry->previous = nullptr;
+    entry->next = nullptr;
+}
+
+void TimerWheel::cascade(int level, size_t index)
+{
+    TimerEntry *head = &slots[level][index];
+
+    while (head->next != head)
+    {
+        TimerEntry *entry = head->next;
+        unlink(entry);
+        insert(entry);
+    }
+}
+
+void TimerWheel::schedule(TimerEntry *entry, uint64_t ticks)
+{
+    if (entry->isScheduled())
+    {
+        unlink(entry);
+    }
+    else
+    {
+        scheduled++;
+    }
+
+    // Timers past the range of the outermost level are held at its end
+    uint64_t last = now | (TIMER_WHEEL_RANGE - 1);
+    entry->expiry = ticks == 0 ? now + 1 : (ticks > last - now ? last : now + ticks);
+    if (entry->expiry <= now)
+    {
+        entry->expiry = now + 1;
+    }
+
+    insert(entry);
+}
+
+void TimerWheel::cancel(TimerEntry *entry)
+{
+    if (entry->isScheduled())
+    {
+        unlink(entry);
+        scheduled--;
+    }
+}
+
+void TimerWheel::advance(uint64_t tick, const std::function<void(TimerEntry *)> &expired)
+{
+    while (now < tick)
+    {
+        // Nothing can expire, so the wheel can jump straight to the tick
+        if (scheduled == 0)
+        {
+            now = tick;
+            return;
+        }
+
+        now++;
+
+        int levels = 0;
+        while (levels < TIMER_WHEEL_LEVELS - 1 && (now & (((uint64_t)1 << ((levels + 1) * TIMER_WHEEL_BITS)) - 1)) == 0)
+        {
+            levels++;
+        }
+
+        for (int level = levels; level > 0; level--)
+        {
+            cascade(level, (now >> (level * TIMER_WHEEL_BITS)) & TIMER_WHEEL_MASK);
+        }
+
+        TimerEntry *head = &slots[0][now & TIMER_WHEEL_MASK];
+        while (head->next != head)
+        {
+            TimerEntry *entry = head->next;
+            unlink(entry);
+            scheduled--;
+            expired(entry);
+        }
+    }
+}
+
+uint64_t TimerWheel::getTick() const
+{
+    return now;
+}
+
+size_t TimerWheel::size() const
+{
+    return scheduled;
+}
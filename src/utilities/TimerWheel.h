@@ -0,0 +1,147 @@
+/*
+ * File: TimerWheel.h
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#ifndef SRC_UTILITIES_TIMERWHEEL
+#define SRC_UTILITIES_TIMERWHEEL
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+
+#define TIMER_WHEEL_BITS 8
+#define TIMER_WHEEL_SLOTS (1 << TIMER_WHEEL_BITS)
+#define TIMER_WHEEL_LEVELS 4
+
+/**
+ * @brief A timer that can be scheduled on a TimerWheel.
+ * Entries are linked into the wheel directly, so they must be cancelled before they are destroyed.
+ *
+ */
+struct TimerEntry
+{
+    TimerEntry *previous = nullptr;
+    TimerEntry *next = nullptr;
+    uint64_t expiry = 0;
+    /**
+     * @brief The object the timer belongs to, passed back when the timer expires
+     *
+     */
+    void *owner = nullptr;
+
+    TimerEntry() = default;
+    TimerEntry(void *owner) : owner(owner){};
+    TimerEntry(const TimerEntry &) = delete;
+    TimerEntry &operator=(const TimerEntry &) = delete;
+
+    bool isScheduled() const
+    {
+        return next != nullptr;
+    }
+};
+
+/**
+ * @brief A hierarchical timing wheel, scheduling and cancelling timers in O(1).
+ * Each level holds TIMER_WHEEL_SLOTS slots covering TIMER_WHEEL_BITS more bits of the expiry than the level
+ * beneath it. Timers on the outer levels are moved inwards as the inner levels wrap, so each timer
+ * is only touched once per level before it expires.
+ *
+ */
+class TimerWheel
+{
+private:
+    /**
+     * @brief The head of each slot's list of timers, the lists are circular
+     *
+     */
+    TimerEntry slots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+    uint64_t now = 0;
+    size_t scheduled = 0;
+
+    /**
+     * @brief Links a timer into the slot for its expiry
+     *
+     * @param entry
+     */
+    void insert(TimerEntry *entry);
+    /**
+     * @brief Removes a timer from its slot
+     *
+     * @param entry
+     */
+    void unlink(TimerEntry *entry);
+    /**
+     * @brief Moves the timers in a slot of an outer level to the levels beneath it
+     *
+     * @param level
+     * @param index
+     */
+    void cascade(int level, size_t index);
+
+public:
+    TimerWheel();
+    TimerWheel(const TimerWheel &) = delete;
+    TimerWheel &operator=(const TimerWheel &) = delete;
+    /**
+     * @brief Schedules a timer, rescheduling it if it's already scheduled
+     *
+     * @param entry
+     * @param ticks The number of ticks until the timer expires, at least 1
+     */
+    void schedule(TimerEntry *entry, uint64_t ticks);
+    /**
+     * @brief Cancels a timer if it's scheduled
+     *
+     * @param entry
+     */
+    void cancel(TimerEntry *entry);
+    /**
+     * @brief Advances the wheel, expiring every timer due up to and including the tick.
+     * Expired timers are no longer scheduled when the callback is run.
+     *
+     * @param tick
+     * @param expired
+     */
+    void advance(uint64_t tick, const std::function<void(TimerEntry *)> &expired);
+    /**
+     * @brief Gets the current tick of the wheel
+     *
+     * @return uint64_t
+     */
+    uint64_t getTick() const;
+    /**
+     * @brief Gets the number of scheduled timers
+     *
+     * @return size_t
+     */
+    size_t size() const;
+};
+
+#endif /* SRC_UTILITIES_TIMERWHEEL */
@@ -0,0 +1,189 @@
+/*
+ * File: TestPayloads.h
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#ifndef TESTS_TESTPAYLOADS
+#define TESTS_TESTPAYLOADS
+
+#include "types/Group.h"
+#include <cstdlib>
+#include <cstring>
+
+/**
+ * @brief Builders for the payloads fed to the model in tests. Payloads are allocated the way decoded payloads
+ * are, so the model and free_payload handle them like received messages.
+ *
+ */
+
+static inline tahu::Payload *createPayload(bool hasSeq, uint64_t seq, uint64_t timestamp = 1)
+{
+    tahu::Payload *payload = (tahu::Payload *)calloc(1, sizeof(tahu::Payload));
+    payload->has_seq = hasSeq;
+    payload->seq = seq;
+    payload->has_timestamp = true;
+    payload->timestamp = timestamp;
+    return payload;
+}
+
+/**
+ * @brief Appends a Metric with no value to a payload
+ *
+ * @return tahu::Metric* The appended Metric, valid until the next Metric is added
+ */
+static inline tahu::Metric *addMetric(tahu::Payload *payload, const char *name, uint32_t datatype)
+{
+    payload->metrics = (tahu::Metric *)realloc(payload->metrics, (payload->metrics_count + 1) * sizeof(tahu::Metric));
+    tahu::Metric *metric = &payload->metrics[payload->metrics_count++];
+    memset(metric, 0, sizeof(tahu::Metric));
+    metric->name = name ? strdup(name) : nullptr;
+    metric->has_datatype = true;
+    metric->datatype = datatype;
+    return metric;
+}
+
+static inline tahu::Metric *addLong(tahu::Payload *payload, const char *name, int64_t value, uint32_t datatype = METRIC_DATA_TYPE_INT64)
+{
+    tahu::Metric *metric = addMetric(payload, name, datatype);
+    metric->which_value = org_eclipse_tahu_protobuf_Payload_Metric_long_value_tag;
+    metric->value.long_value = value;
+    return metric;
+}
+
+static inline tahu::Metric *addInt(tahu::Payload *payload, const char *name, uint32_t value, uint32_t datatype = METRIC_DATA_TYPE_INT32)
+{
+    tahu::Metric *metric = addMetric(payload, name, datatype);
+    metric->which_value = org_eclipse_tahu_protobuf_Payload_Metric_int_value_tag;
+    metric->value.int_value = value;
+    return metric;
+}
+
+static inline tahu::Metric *addBytes(tahu::Payload *payload, const char *name, const char *value, size_t size)
+{
+    tahu::Metric *metric = addMetric(payload, name, METRIC_DATA_TYPE_BYTES);
+    pb_bytes_array_t *bytes = (pb_bytes_array_t *)malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(size));
+    bytes->size = size;
+    memcpy(bytes->bytes, value, size);
+    metric->which_value = org_eclipse_tahu_protobuf_Payload_Metric_bytes_value_tag;
+    metric->value.bytes_value = bytes;
+    return metric;
+}
+
+static inline tahu::Metric *addNull(tahu::Payload *payload, const char *name, uint32_t datatype)
+{
+    tahu::Metric *metric = addMetric(payload, name, datatype);
+    metric->has_is_null = true;
+    metric->is_null = true;
+    return metric;
+}
+
+/**
+ * @brief A Node birth payload carrying its bdSeq
+ *
+ */
+static inline tahu::Payload *createBirth(uint64_t bdSeq)
+{
+    tahu::Payload *payload = createPayload(true, 0);
+    addLong(payload, "bdSeq", bdSeq);
+    return payload;
+}
+
+/**
+ * @brief A Node death payload carrying the bdSeq of the session it ends
+ *
+ */
+static inline tahu::Payload *createDeath(uint64_t bdSeq)
+{
+    tahu::Payload *payload = createPayload(false, 0);
+    addLong(payload, "bdSeq", bdSeq);
+    return payload;
+}
+
+static inline void releasePayload(tahu::Payload *payload)
+{
+    free_payload(payload);
+    free(payload);
+}
+
+/**
+ * @brief Applies a payload to a Group as if it was received on a topic, then releases it.
+ * Limited payloads are handed to their Node to be applied later, as the Host does.
+ *
+ */
+static inline ParseResult send(Group &group, std::string topicName, tahu::Payload *payload)
+{
+    SparkplugTopic topic;
+
+    if (!topic.parse(topicName))
+    {
+        releasePayload(payload);
+        return ParseResult::DO_NOTHING;
+    }
+
+    ParseResult result = group.process(topic, payload);
+
+    if (result == ParseResult::LIMITED)
+    {
+        group.find(group.getName() + "/" + topic.getNode())->defer(topic, payload, nullptr);
+        return result;
+    }
+
+    releasePayload(payload);
+    return result;
+}
+
+/**
+ * @brief Releases the payloads of a list of updates
+ *
+ */
+static inline void releaseUpdates(std::vector<PublishableUpdate> &updates)
+{
+    for (auto &update : updates)
+    {
+        if (update.payload)
+        {
+            releasePayload(update.payload);
+        }
+    }
+    updates.clear();
+}
+
+static inline const PublishableUpdate *findUpdate(const std::vector<PublishableUpdate> &updates, const std::string &id)
+{
+    for (auto &update : updates)
+    {
+        if (update.id == id)
+        {
+            return &update;
+        }
+    }
+    return nullptr;
+}
+
+#endif /* TESTS_TESTPAYLOADS */
@@ -0,0 +1,132 @@
+/*
+ * File: birth_diff_test.cpp
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#include "Expect.h"
+#include "TestPayloads.h"
+#include <algorithm>
+
+static bool contains(const std::vector<std::string> &names, const char *name)
+{
+    return std::find(names.begin(), names.end(), name) != names.end();
+}
+
+static std::shared_ptr<const BirthDiff> readBirth(Group &group, const std::string &id)
+{
+    std::vector<PublishableUpdate> updates;
+    group.appendTo(updates);
+    const PublishableUpdate *update = findUpdate(updates, id);
+    EXPECT(update && update->type == UpdateType::BIRTH);
+    std::shared_ptr<const BirthDiff> diff = update ? update->diff : nullptr;
+    releaseUpdates(updates);
+    return diff;
+}
+
+/**
+ * @brief Rebirths report the Metrics added, removed and retyped since the previous birth, keeping the others
+ *
+ */
+static void rebirth()
+{
+    ModelContext context;
+    Group group("G", &context);
+
+    tahu::Payload *birth = createBirth(1);
+    addLong(birth, "kept", 1);
+    addLong(birth, "retyped", 1);
+    addLong(birth, "removed", 1);
+    EXPECT(send(group, "spBv1.0/G/NBIRTH/n", birth) == ParseResult::OK);
+
+    auto diff = readBirth(group, "G/n");
+    EXPECT(diff && diff->initial);
+    EXPECT(diff && diff->added.empty() && diff->removed.empty() && diff->retyped.empty());
+
+    Publishable *node = group.find("G/n");
+    Metric *kept = node->find("kept");
+
+    birth = createBirth(2);
+    addLong(birth, "kept", 2);
+    addInt(birth, "retyped", 2);
+    addLong(birth, "added", 2);
+    EXPECT(send(group, "spBv1.0/G/NBIRTH/n", birth) == ParseResult::OK);
+
+    diff = readBirth(group, "G/n");
+    EXPECT(diff && !diff->initial);
+    EXPECT(diff && diff->added.size() == 1 && contains(diff->added, "added"));
+    EXPECT(diff && diff->removed.size() == 1 && contains(diff->removed, "removed"));
+    EXPECT(diff && diff->retyped.size() == 1 && contains(diff->retyped, "retyped"));
+
+    // Kept Metrics are reused, removed Metrics are gone
+    EXPECT(node->find("kept") == kept);
+    EXPECT(!node->find("removed"));
+    EXPECT(node->find("retyped")->getType() == METRIC_DATA_TYPE_INT32);
+    ScalarValue scalar;
+    EXPECT(node->find("retyped")->getValue().readScalar(scalar) && scalar.intValue == 2);
+}
+
+/**
+ * @brief An identical rebirth reports an empty diff, and data never carries one
+ *
+ */
+static void unchanged()
+{
+    ModelContext context;
+    Group group("G", &context);
+
+    tahu::Payload *birth = createBirth(1);
+    addLong(birth, "value", 1);
+    EXPECT(send(group, "spBv1.0/G/NBIRTH/n", birth) == ParseResult::OK);
+    readBirth(group, "G/n");
+
+    tahu::Payload *data = createPayload(true, 1);
+    addLong(data, "value", 2);
+    EXPECT(send(group, "spBv1.0/G/NDATA/n", data) == ParseResult::OK);
+
+    std::vector<PublishableUpdate> updates;
+    group.appendTo(updates);
+    EXPECT(updates.size() == 1 && updates[0].type == UpdateType::PUBLISH && !updates[0].diff);
+    releaseUpdates(updates);
+
+    birth = createBirth(2);
+    addLong(birth, "value", 3);
+    EXPECT(send(group, "spBv1.0/G/NBIRTH/n", birth) == ParseResult::OK);
+
+    auto diff = readBirth(group, "G/n");
+    EXPECT(diff && !diff->initial);
+    EXPECT(diff && diff->added.empty() && diff->removed.empty() && diff->retyped.empty());
+}
+
+int main()
+{
+    rebirth();
+    unchanged();
+
+    return failures;
+}
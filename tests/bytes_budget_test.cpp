@@ -0,0 +1,159 @@
+/*
+ * File: bytes_budget_test.cpp
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#include "Expect.h"
+#include "TestPayloads.h"
+
+/**
+ * @brief Tracks the versions of evicted Nodes and Devices the way SparkplugHost does after each batch
+ *
+ */
+static void trackEvictions(Group &group, ModelContext &context)
+{
+    for (Publishable *publisher : context.evicted)
+    {
+        group.track(publisher);
+    }
+    context.evicted.clear();
+}
+
+static tahu::Metric *findMetric(const PublishableUpdate *update, const char *name)
+{
+    for (size_t i = 0; update && update->payload && i < update->payload->metrics_count; i++)
+    {
+        if (strcmp(update->payload->metrics[i].name, name) == 0)
+        {
+            return &update->payload->metrics[i];
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Bytes evicted to make room for another Node's Bytes are published as null, and stored again when republished
+ *
+ */
+static void eviction()
+{
+    ModelContext context;
+    context.bytes.limit(0, 12);
+    Group group("G", &context);
+    std::vector<PublishableUpdate> updates;
+
+    tahu::Payload *birth = createBirth(1);
+    addBytes(birth, "blob", "12345678", 8);
+    EXPECT(send(group, "spBv1.0/G/NBIRTH/a", birth) == ParseResult::OK);
+    group.appendTo(updates);
+    releaseUpdates(updates);
+
+    uint64_t cursor = context.version;
+
+    birth = createBirth(1);
+    addBytes(birth, "blob", "abcdefgh", 8);
+    EXPECT(send(group, "spBv1.0/G/NBIRTH/b", birth) == ParseResult::OK);
+    EXPECT(context.evicted.size() == 1);
+    trackEvictions(group, context);
+
+    Metric *evicted = ((Publishable *)group.find("G/a"))->find("blob");
+    EXPECT(evicted->isDirty());
+    EXPECT(evicted->getValue().getBytes()->isEvicted());
+
+    group.appendTo(updates);
+    const PublishableUpdate *update = findUpdate(updates, "G/a");
+    EXPECT(update && update->type == UpdateType::PUBLISH);
+    tahu::Metric *metric = findMetric(update, "blob");
+    EXPECT(metric && metric->is_null);
+    releaseUpdates(updates);
+
+    // Consumers reading through a cursor see the eviction too
+    group.appendSince(updates, cursor);
+    update = findUpdate(updates, "G/a");
+    metric = findMetric(update, "blob");
+    EXPECT(metric && metric->is_null);
+    releaseUpdates(updates);
+
+    // The same bytes republished are stored again, evicting the other Node's bytes in turn
+    tahu::Payload *data = createPayload(true, 1);
+    addBytes(data, "blob", "12345678", 8);
+    EXPECT(send(group, "spBv1.0/G/NDATA/a", data) == ParseResult::OK);
+    EXPECT(evicted->isDirty());
+    EXPECT(!evicted->getValue().getBytes()->isEvicted());
+    EXPECT(context.evicted.size() == 1);
+    trackEvictions(group, context);
+
+    group.appendTo(updates);
+    metric = findMetric(findUpdate(updates, "G/a"), "blob");
+    EXPECT(metric && !metric->is_null && metric->value.bytes_value->size == 8);
+    metric = findMetric(findUpdate(updates, "G/b"), "blob");
+    EXPECT(metric && metric->is_null);
+    releaseUpdates(updates);
+}
+
+/**
+ * @brief Bytes over the per Metric limit are dropped and stay null while they're republished
+ *
+ */
+static void dropped()
+{
+    ModelContext context;
+    context.bytes.limit(4, 0);
+    Group group("G", &context);
+    std::vector<PublishableUpdate> updates;
+
+    tahu::Payload *birth = createBirth(1);
+    addBytes(birth, "blob", "12", 2);
+    EXPECT(send(group, "spBv1.0/G/NBIRTH/a", birth) == ParseResult::OK);
+    group.appendTo(updates);
+    releaseUpdates(updates);
+
+    tahu::Payload *data = createPayload(true, 1);
+    addBytes(data, "blob", "12345678", 8);
+    EXPECT(send(group, "spBv1.0/G/NDATA/a", data) == ParseResult::OK);
+    group.appendTo(updates);
+    tahu::Metric *metric = findMetric(findUpdate(updates, "G/a"), "blob");
+    EXPECT(metric && metric->is_null);
+    releaseUpdates(updates);
+
+    uint64_t version = context.version;
+    data = createPayload(true, 2);
+    addBytes(data, "blob", "abcdefgh", 8);
+    EXPECT(send(group, "spBv1.0/G/NDATA/a", data) == ParseResult::OK);
+    EXPECT(context.version == version);
+    EXPECT(context.evicted.empty());
+}
+
+int main()
+{
+    eviction();
+    dropped();
+
+    return failures;
+}
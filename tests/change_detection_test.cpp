@@ -0,0 +1,359 @@
+/*
+ * File: change_detection_test.cpp
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#include "Expect.h"
+#include "types/Bytes.h"
+#include "types/Metric.h"
+#include "types/PropertySet.h"
+#include <cstdlib>
+#include <cstring>
+
+static const char *COLUMNS[] = {"id", "name"};
+static const uint32_t COLUMN_TYPES[] = {DATA_SET_DATA_TYPE_INT32, DATA_SET_DATA_TYPE_STRING};
+
+/**
+ * @brief Builds a DataSet Metric of (id, name) rows, freed with freeDataSet
+ *
+ */
+static void buildDataSet(tahu::Metric &metric, const uint32_t *ids, const char **names, size_t rows)
+{
+    memset(&metric, 0, sizeof(metric));
+    metric.name = (char *)"dataset";
+    metric.has_datatype = true;
+    metric.datatype = METRIC_DATA_TYPE_DATASET;
+    metric.which_value = org_eclipse_tahu_protobuf_Payload_Metric_dataset_value_tag;
+
+    tahu::DataSet &dataSet = metric.value.dataset_value;
+    dataSet.columns = (char **)COLUMNS;
+    dataSet.columns_count = 2;
+    dataSet.types = (uint32_t *)COLUMN_TYPES;
+    dataSet.types_count = 2;
+    dataSet.rows_count = rows;
+    dataSet.rows = (tahu::DataSetRow *)calloc(rows, sizeof(tahu::DataSetRow));
+
+    for (size_t row = 0; row < rows; row++)
+    {
+        tahu::DataSetValue *elements = (tahu::DataSetValue *)calloc(2, sizeof(tahu::DataSetValue));
+        elements[0].which_value = org_eclipse_tahu_protobuf_Payload_DataSet_DataSetValue_int_value_tag;
+        elements[0].value.int_value = ids[row];
+        elements[1].which_value = org_eclipse_tahu_protobuf_Payload_DataSet_DataSetValue_string_value_tag;
+        elements[1].value.string_value = (char *)names[row];
+
+        dataSet.rows[row].elements = elements;
+        dataSet.rows[row].elements_count = 2;
+    }
+}
+
+static void freeDataSet(tahu::Metric &metric)
+{
+    tahu::DataSet &dataSet = metric.value.dataset_value;
+    for (size_t row = 0; row < dataSet.rows_count; row++)
+    {
+        free(dataSet.rows[row].elements);
+    }
+    free(dataSet.rows);
+}
+
+/**
+ * @brief Builds an array Metric, freed with free(metric.value.bytes_value)
+ *
+ */
+static void buildArray(tahu::Metric &metric, uint32_t datatype, const void *data, size_t size)
+{
+    memset(&metric, 0, sizeof(metric));
+    metric.name = (char *)"array";
+    metric.has_datatype = true;
+    metric.datatype = datatype;
+    metric.which_value = org_eclipse_tahu_protobuf_Payload_Metric_bytes_value_tag;
+
+    pb_bytes_array_t *bytes = (pb_bytes_array_t *)malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(size));
+    bytes->size = size;
+    memcpy(bytes->bytes, data, size);
+    metric.value.bytes_value = bytes;
+}
+
+/**
+ * @brief Publishes a Metric's pending changes, leaving it clean
+ *
+ */
+static void publish(Metric &metric)
+{
+    tahu::Payload payload;
+    memset(&payload, 0, sizeof(payload));
+    metric.appendTo(&payload);
+    free_payload(&payload);
+}
+
+static void dataSet()
+{
+    std::string name = "dataset";
+    Metric metric(name);
+    tahu::Metric input;
+
+    uint32_t ids[] = {1, 2, 3};
+    const char *names[] = {"a", "b", "c"};
+    buildDataSet(input, ids, names, 3);
+    EXPECT(metric.process(&input) == ParseResult::OK);
+    EXPECT(metric.isDirty());
+    freeDataSet(input);
+    publish(metric);
+    EXPECT(!metric.isDirty());
+
+    // The same rows again
+    buildDataSet(input, ids, names, 3);
+    EXPECT(metric.process(&input) == ParseResult::OK);
+    EXPECT(!metric.isDirty());
+    freeDataSet(input);
+
+    // A single changed cell
+    const char *renamed[] = {"a", "B", "c"};
+    buildDataSet(input, ids, renamed, 3);
+    EXPECT(metric.process(&input) == ParseResult::OK);
+    EXPECT(metric.isDirty());
+    freeDataSet(input);
+    publish(metric);
+
+    // An unchanged republish after a change stays clean, even though the change is still tracked for deltas
+    buildDataSet(input, ids, renamed, 3);
+    EXPECT(metric.process(&input) == ParseResult::OK);
+    EXPECT(!metric.isDirty());
+    freeDataSet(input);
+}
+
+static void array(bool deltas)
+{
+    std::string name = "array";
+    Metric metric(name);
+    MetricScope scope;
+    scope.arrayDeltas = &deltas;
+    tahu::Metric input;
+
+    int32_t values[64];
+    for (int i = 0; i < 64; i++)
+    {
+        values[i] = i;
+    }
+
+    buildArray(input, METRIC_DATA_TYPE_INT32ARRAY, values, sizeof(values));
+    EXPECT(metric.process(&input, &scope) == ParseResult::OK);
+    EXPECT(metric.isDirty());
+    free(input.value.bytes_value);
+    publish(metric);
+
+    buildArray(input, METRIC_DATA_TYPE_INT32ARRAY, values, sizeof(values));
+    EXPECT(metric.process(&input, &scope) == ParseResult::OK);
+    EXPECT(!metric.isDirty());
+    free(input.value.bytes_value);
+
+    values[40] = -1;
+    buildArray(input, METRIC_DATA_TYPE_INT32ARRAY, values, sizeof(values));
+    EXPECT(metric.process(&input, &scope) == ParseResult::OK);
+    EXPECT(metric.isDirty());
+    free(input.value.bytes_value);
+    publish(metric);
+
+    buildArray(input, METRIC_DATA_TYPE_INT32ARRAY, values, sizeof(values));
+    EXPECT(metric.process(&input, &scope) == ParseResult::OK);
+    EXPECT(!metric.isDirty());
+    free(input.value.bytes_value);
+}
+
+static void stringArray()
+{
+    std::string name = "array";
+    Metric metric(name);
+    tahu::Metric input;
+
+    const char values[] = "ab\0\0cde";
+    buildArray(input, METRIC_DATA_TYPE_STRINGARRAY, values, sizeof(values));
+    EXPECT(metric.process(&input) == ParseResult::OK);
+    free(input.value.bytes_value);
+    publish(metric);
+
+    buildArray(input, METRIC_DATA_TYPE_STRINGARRAY, values, sizeof(values));
+    EXPECT(metric.process(&input) == ParseResult::OK);
+    EXPECT(!metric.isDirty());
+    free(input.value.bytes_value);
+
+    const char changed[] = "ab\0x\0cde";
+    buildArray(input, METRIC_DATA_TYPE_STRINGARRAY, changed, sizeof(changed));
+    EXPECT(metric.process(&input) == ParseResult::OK);
+    EXPECT(metric.isDirty());
+    free(input.value.bytes_value);
+}
+
+/**
+ * @brief Builds a null Metric of a datatype
+ *
+ */
+static void buildNull(tahu::Metric &metric, uint32_t datatype)
+{
+    memset(&metric, 0, sizeof(metric));
+    metric.name = (char *)"null";
+    metric.has_datatype = true;
+    metric.datatype = datatype;
+    metric.has_is_null = metric.is_null = true;
+}
+
+static void nullDataSet()
+{
+    std::string name = "dataset";
+    Metric metric(name);
+    uint64_t version = 0;
+    MetricScope scope;
+    scope.version = &version;
+    tahu::Metric input;
+
+    uint32_t ids[] = {1};
+    const char *names[] = {"a"};
+    buildDataSet(input, ids, names, 1);
+    EXPECT(metric.process(&input, &scope) == ParseResult::OK);
+    freeDataSet(input);
+    publish(metric);
+
+    // A value going null is a change
+    buildNull(input, METRIC_DATA_TYPE_DATASET);
+    EXPECT(metric.process(&input, &scope) == ParseResult::OK);
+    EXPECT(metric.isDirty());
+    EXPECT(metric.getVersion() == 2);
+    publish(metric);
+
+    // Staying null isn't
+    EXPECT(metric.process(&input, &scope) == ParseResult::OK);
+    EXPECT(!metric.isDirty());
+    EXPECT(version == 2);
+
+    buildDataSet(input, ids, names, 1);
+    EXPECT(metric.process(&input, &scope) == ParseResult::OK);
+    EXPECT(metric.isDirty());
+    EXPECT(version == 3);
+    freeDataSet(input);
+}
+
+static void bytes()
+{
+    std::string name = "bytes";
+    Metric metric(name);
+    uint64_t version = 0;
+    BytesBudget budget;
+    MetricScope scope;
+    scope.version = &version;
+    scope.bytes = &budget;
+    tahu::Metric input;
+
+    buildArray(input, METRIC_DATA_TYPE_BYTES, "abcd", 4);
+    EXPECT(metric.process(&input, &scope) == ParseResult::OK);
+    EXPECT(version == 1);
+    publish(metric);
+
+    // Ownership of the bytes moved to the Metric
+    buildArray(input, METRIC_DATA_TYPE_BYTES, "abcd", 4);
+    EXPECT(metric.process(&input, &scope) == ParseResult::OK);
+    EXPECT(!metric.isDirty());
+
+    buildArray(input, METRIC_DATA_TYPE_BYTES, "abce", 4);
+    EXPECT(metric.process(&input, &scope) == ParseResult::OK);
+    EXPECT(metric.isDirty());
+    EXPECT(version == 2);
+    publish(metric);
+
+    // Bytes over the limits are dropped and reported as null, so they only change once they're held again
+    budget.limit(2, 0);
+    buildArray(input, METRIC_DATA_TYPE_BYTES, "abce", 4);
+    EXPECT(metric.process(&input, &scope) == ParseResult::OK);
+    EXPECT(metric.getValue().getBytes()->isEvicted());
+    EXPECT(version == 3);
+    buildArray(input, METRIC_DATA_TYPE_BYTES, "abcf", 4);
+    EXPECT(metric.process(&input, &scope) == ParseResult::OK);
+    EXPECT(version == 3);
+    buildNull(input, METRIC_DATA_TYPE_BYTES);
+    EXPECT(metric.process(&input, &scope) == ParseResult::OK);
+    EXPECT(version == 3);
+    budget.limit(0, 0);
+
+    buildArray(input, METRIC_DATA_TYPE_BYTES, "abcf", 4);
+    EXPECT(metric.process(&input, &scope) == ParseResult::OK);
+    EXPECT(version == 4);
+
+    buildNull(input, METRIC_DATA_TYPE_BYTES);
+    EXPECT(metric.process(&input, &scope) == ParseResult::OK);
+    EXPECT(metric.isDirty());
+    EXPECT(version == 5);
+}
+
+static void propertySet()
+{
+    const char *keys[] = {"engUnit", "Quality"};
+    tahu::Property values[2];
+    memset(values, 0, sizeof(values));
+    values[0].type = PROPERTY_DATA_TYPE_STRING;
+    values[0].value.string_value = (char *)"degC";
+    values[1].type = PROPERTY_DATA_TYPE_INT32;
+    values[1].value.int_value = 192;
+
+    tahu::PropertySet input;
+    memset(&input, 0, sizeof(input));
+    input.keys = (char **)keys;
+    input.keys_count = 2;
+    input.values = values;
+    input.values_count = 2;
+
+    PropertySet properties;
+    EXPECT(properties.process(&input) == ParseResult::OK);
+    EXPECT(properties.isDirty());
+
+    tahu::PropertySet output;
+    memset(&output, 0, sizeof(output));
+    properties.appendTo(&output);
+    pb_release(org_eclipse_tahu_protobuf_Payload_PropertySet_fields, &output);
+    EXPECT(!properties.isDirty());
+
+    EXPECT(properties.process(&input) == ParseResult::OK);
+    EXPECT(!properties.isDirty());
+
+    values[1].value.int_value = 0;
+    EXPECT(properties.process(&input) == ParseResult::OK);
+    EXPECT(properties.isDirty());
+    EXPECT(properties.find("Quality")->value.intValue == 0);
+}
+
+int main()
+{
+    dataSet();
+    array(false);
+    array(true);
+    stringArray();
+    nullDataSet();
+    bytes();
+    propertySet();
+
+    return failures;
+}
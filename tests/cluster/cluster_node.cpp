@@ -0,0 +1,204 @@
+/*
+ * File: cluster_node.cpp
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+/**
+ * @brief Runs either side of the cluster test against a broker.
+ *
+ * cluster_node edge <server> <nodes>
+ *      Publishes a birth for each Node of the Group "cluster", then data every 100ms, and rebirths a Node
+ *      whenever it is sent a command.
+ * cluster_node host <server> <instance>
+ *      Joins the cluster "test" and prints the Nodes and Devices it owns every 500ms as
+ *      "owned <id> <id> ...".
+ *
+ * Both run until they receive SIGINT or SIGTERM.
+ */
+
+#include "SparkplugHost.h"
+#include "mqtt/async_client.h"
+#include <algorithm>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+#define CLUSTER_GROUP "cluster"
+
+static std::atomic<bool> stopping = false;
+
+static void onSignal(int)
+{
+    stopping = true;
+}
+
+/**
+ * @brief A simulated Edge Node with a single Metric
+ *
+ */
+struct EdgeNode
+{
+    std::string name;
+    uint64_t seq = 0;
+    int64_t value = 0;
+    std::atomic<bool> rebirth = true;
+};
+
+static void publish(mqtt::async_client &client, const std::string &topic, tahu::Payload *payload)
+{
+    size_t length = 2048;
+    uint8_t *buffer = (uint8_t *)malloc(length);
+    size_t size = encode_payload(buffer, length, payload);
+    client.publish(mqtt::message::create(topic, buffer, size, 0, false));
+    free(buffer);
+    free_payload(payload);
+}
+
+static void send(mqtt::async_client &client, EdgeNode &node, bool birth)
+{
+    tahu::Payload payload;
+    memset(&payload, 0, sizeof(payload));
+    payload.has_timestamp = true;
+    payload.timestamp = get_current_timestamp();
+
+    if (birth)
+    {
+        node.seq = 0;
+        int64_t bdSeq = 0;
+        add_simple_metric(&payload, "bdSeq", false, 0, METRIC_DATA_TYPE_INT64, false, false, &bdSeq, sizeof(bdSeq));
+    }
+
+    payload.has_seq = true;
+    payload.seq = node.seq;
+    node.seq = (node.seq + 1) % 256;
+
+    node.value++;
+    add_simple_metric(&payload, "value", false, 0, METRIC_DATA_TYPE_INT64, false, false, &node.value, sizeof(node.value));
+
+    publish(client, std::string("spBv1.0/" CLUSTER_GROUP) + (birth ? "/NBIRTH/" : "/NDATA/") + node.name, &payload);
+}
+
+static int edge(const std::string &server, int count)
+{
+    std::vector<EdgeNode> nodes(count);
+    for (int i = 0; i < count; i++)
+    {
+        nodes[i].name = "node" + std::to_string(i);
+    }
+
+    mqtt::async_client client(server, "cluster_edge", mqtt::create_options(MQTTVERSION_5));
+    client.set_message_callback([&nodes](mqtt::const_message_ptr message)
+                                {
+        // spBv1.0/cluster/NCMD/<node>, every command is treated as a rebirth request
+        const std::string &topic = message->get_topic();
+        std::string name = topic.substr(topic.rfind('/') + 1);
+        for (auto &node : nodes)
+        {
+            if (node.name == name)
+            {
+                node.rebirth = true;
+            }
+        } });
+
+    client.connect(mqtt::connect_options_builder().clean_start(true).finalize())->wait();
+    client.subscribe("spBv1.0/" CLUSTER_GROUP "/NCMD/+", 0)->wait();
+
+    while (!stopping)
+    {
+        for (auto &node : nodes)
+        {
+            send(client, node, node.rebirth.exchange(false));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    client.disconnect()->wait();
+    return 0;
+}
+
+static int host(const std::string &server, const std::string &instance)
+{
+    SparkplugHost host(server, "cluster_" + instance);
+    host.join("test", instance, ClusterPartition::NODE, std::chrono::milliseconds(500));
+
+    std::thread runner([&host]()
+                       { host.run(); });
+
+    while (!stopping)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+        std::vector<std::string> owned;
+        for (auto &update : host.getPayloads(true))
+        {
+            if (update.type != UpdateType::DEATH)
+            {
+                owned.push_back(update.id);
+            }
+            if (update.payload)
+            {
+                free_payload(update.payload);
+                free(update.payload);
+            }
+        }
+        std::sort(owned.begin(), owned.end());
+
+        printf("owned");
+        for (auto &id : owned)
+        {
+            printf(" %s", id.c_str());
+        }
+        printf("\n");
+        fflush(stdout);
+    }
+
+    host.stop();
+    runner.join();
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+
+    if (argc == 4 && strcmp(argv[1], "edge") == 0)
+    {
+        return edge(argv[2], atoi(argv[3]));
+    }
+
+    if (argc == 4 && strcmp(argv[1], "host") == 0)
+    {
+        return host(argv[2], argv[3]);
+    }
+
+    fprintf(stderr, "usage: %s edge <server> <nodes> | host <server> <instance>\n", argv[0]);
+    return 1;
+}
@@ -0,0 +1,70 @@
+#!/bin/bash
+#
+# Runs two clustered hosts against a local mosquitto broker and checks that:
+#   - together they own every Node, and no Node is owned by both
+#   - the remaining host takes over every Node once the other stops heartbeating
+#
+# usage: cluster_test.sh <cluster_node binary>
+# Exits with 77 (skipped) when mosquitto is not installed.
+
+NODE_BIN="$1"
+PORT="${CLUSTER_TEST_PORT:-18830}"
+SERVER="tcp://localhost:$PORT"
+NODES=8
+WORK="$(mktemp -d)"
+
+if ! command -v mosquitto > /dev/null; then
+    echo "mosquitto not found, skipping"
+    exit 77
+fi
+
+cleanup() {
+    kill $(jobs -p) 2> /dev/null
+    wait 2> /dev/null
+    rm -rf "$WORK"
+}
+trap cleanup EXIT
+
+fail() {
+    echo "FAIL: $1"
+    echo "--- host a:"; tail -n 3 "$WORK/a.log"
+    echo "--- host b:"; tail -n 3 "$WORK/b.log"
+    exit 1
+}
+
+# The Nodes a host owned in its latest report, one per line
+owned() {
+    grep '^owned' "$WORK/$1.log" | tail -n 1 | tr ' ' '\n' | tail -n +2 | sort
+}
+
+mosquitto -p "$PORT" > "$WORK/broker.log" 2>&1 &
+sleep 1
+
+"$NODE_BIN" host "$SERVER" a > "$WORK/a.log" 2>&1 &
+"$NODE_BIN" host "$SERVER" b > "$WORK/b.log" 2>&1 &
+HOST_B=$!
+sleep 1
+"$NODE_BIN" edge "$SERVER" "$NODES" > "$WORK/edge.log" 2>&1 &
+
+# Memberships settle after a few heartbeats, the Nodes are rebirthed to their owners
+sleep 6
+
+owned a > "$WORK/a.owned"
+owned b > "$WORK/b.owned"
+
+[ -s "$WORK/a.owned" ] || fail "host a owns no Nodes"
+[ -s "$WORK/b.owned" ] || fail "host b owns no Nodes"
+[ -z "$(comm -12 "$WORK/a.owned" "$WORK/b.owned")" ] || fail "Nodes owned by both hosts"
+[ "$(sort -u "$WORK/a.owned" "$WORK/b.owned" | wc -l)" -eq "$NODES" ] || fail "Nodes owned by neither host"
+
+echo "split: a=$(wc -l < "$WORK/a.owned") b=$(wc -l < "$WORK/b.owned")"
+
+# A killed host never announces it is offline, the other host must expire it from missed heartbeats
+kill -9 "$HOST_B"
+sleep 5
+
+owned a > "$WORK/a.owned"
+[ "$(wc -l < "$WORK/a.owned")" -eq "$NODES" ] || fail "host a did not take over every Node"
+
+echo "rebalanced: a=$(wc -l < "$WORK/a.owned")"
+echo "PASS"
@@ -0,0 +1,159 @@
+/*
+ * File: cursor_test.cpp
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#include "Expect.h"
+#include "TestPayloads.h"
+
+/**
+ * @brief Reads the changes since a cursor the way SparkplugHost::getChanges does, advancing the cursor
+ *
+ */
+static std::vector<PublishableUpdate> changes(Group &group, ModelContext &context, uint64_t &cursor)
+{
+    std::vector<PublishableUpdate> updates;
+    group.appendSince(updates, cursor);
+    cursor = context.version;
+    return updates;
+}
+
+/**
+ * @brief A consumer that only reads through a cursor sees a birth, the data after it and the death that ends it
+ *
+ */
+static void lifecycle()
+{
+    ModelContext context;
+    Group group("G", &context);
+    uint64_t cursor = 0;
+
+    tahu::Payload *birth = createBirth(1);
+    addLong(birth, "value", 1);
+    EXPECT(send(group, "spBv1.0/G/NBIRTH/n", birth) == ParseResult::OK);
+
+    auto updates = changes(group, context, cursor);
+    EXPECT(updates.size() == 1 && updates[0].type == UpdateType::BIRTH);
+    releaseUpdates(updates);
+
+    tahu::Payload *data = createPayload(true, 1);
+    addLong(data, "value", 2);
+    EXPECT(send(group, "spBv1.0/G/NDATA/n", data) == ParseResult::OK);
+
+    updates = changes(group, context, cursor);
+    EXPECT(updates.size() == 1 && updates[0].type == UpdateType::PUBLISH);
+    EXPECT(updates.size() == 1 && updates[0].payload->metrics_count == 1);
+    releaseUpdates(updates);
+
+    // Nothing changed since the last read
+    updates = changes(group, context, cursor);
+    EXPECT(updates.empty());
+
+    EXPECT(send(group, "spBv1.0/G/NDEATH/n", createDeath(1)) == ParseResult::OK);
+
+    updates = changes(group, context, cursor);
+    EXPECT(updates.size() == 1 && updates[0].type == UpdateType::DEATH);
+    releaseUpdates(updates);
+}
+
+/**
+ * @brief A death straight after a birth ends the session even though the birth was never read
+ *
+ */
+static void unreadBirth()
+{
+    ModelContext context;
+    Group group("G", &context);
+    uint64_t cursor = 0;
+
+    EXPECT(send(group, "spBv1.0/G/NBIRTH/n", createBirth(1)) == ParseResult::OK);
+    EXPECT(send(group, "spBv1.0/G/NDEATH/n", createDeath(1)) == ParseResult::OK);
+
+    Node *node = group.find("G/n");
+    EXPECT(node && !node->isAlive());
+
+    auto updates = changes(group, context, cursor);
+    EXPECT(updates.size() == 1 && updates[0].type == UpdateType::DEATH);
+    releaseUpdates(updates);
+}
+
+/**
+ * @brief Each cursor receives every change once, independently of the other cursors
+ *
+ */
+static void independent()
+{
+    ModelContext context;
+    Group group("G", &context);
+    uint64_t first = 0;
+    uint64_t second = 0;
+
+    tahu::Payload *birth = createBirth(1);
+    addLong(birth, "a", 1);
+    addLong(birth, "b", 1);
+    send(group, "spBv1.0/G/NBIRTH/n", birth);
+
+    auto updates = changes(group, context, first);
+    releaseUpdates(updates);
+
+    tahu::Payload *data = createPayload(true, 1);
+    addLong(data, "a", 2);
+    send(group, "spBv1.0/G/NDATA/n", data);
+
+    // The first cursor only sees the change, the second missed the birth so it's sent every Metric
+    updates = changes(group, context, first);
+    EXPECT(updates.size() == 1 && updates[0].type == UpdateType::PUBLISH && updates[0].payload->metrics_count == 1);
+    releaseUpdates(updates);
+
+    updates = changes(group, context, second);
+    EXPECT(updates.size() == 1 && updates[0].type == UpdateType::BIRTH && updates[0].payload->metrics_count == 3);
+    releaseUpdates(updates);
+
+    // getPayloads acknowledging the changes doesn't affect the cursors
+    std::vector<PublishableUpdate> acknowledged;
+    group.appendTo(acknowledged);
+    releaseUpdates(acknowledged);
+
+    data = createPayload(true, 2);
+    addLong(data, "b", 2);
+    send(group, "spBv1.0/G/NDATA/n", data);
+
+    updates = changes(group, context, second);
+    EXPECT(updates.size() == 1 && updates[0].payload->metrics_count == 1);
+    releaseUpdates(updates);
+}
+
+int main()
+{
+    lifecycle();
+    unreadBirth();
+    independent();
+
+    return failures;
+}
@@ -0,0 +1,125 @@
+/*
+ * File: death_cascade_test.cpp
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#include "Expect.h"
+#include "TestPayloads.h"
+
+static void birth(Group &group, uint64_t bdSeq, std::vector<const char *> devices)
+{
+    EXPECT(send(group, "spBv1.0/G/NBIRTH/n", createBirth(bdSeq)) == ParseResult::OK);
+
+    uint64_t seq = 1;
+    for (auto device : devices)
+    {
+        tahu::Payload *payload = createPayload(true, seq++);
+        addLong(payload, "value", 1);
+        EXPECT(send(group, std::string("spBv1.0/G/DBIRTH/n/") + device, payload) == ParseResult::OK);
+    }
+}
+
+/**
+ * @brief A Node death stales the Node and all of its Devices, even before the births were read
+ *
+ */
+static void cascade()
+{
+    ModelContext context;
+    Group group("G", &context);
+    birth(group, 5, {"d1", "d2"});
+
+    Node *node = group.find("G/n");
+    EXPECT(node && !node->isStale());
+    EXPECT(!node->findDevice("d1")->isStale() && !node->findDevice("d2")->isStale());
+
+    auto statistics = context.statistics.read();
+    EXPECT(statistics.onlineNodes == 1 && statistics.onlineDevices == 2);
+
+    EXPECT(send(group, "spBv1.0/G/NDEATH/n", createDeath(5)) == ParseResult::OK);
+
+    EXPECT(node->isStale());
+    EXPECT(node->findDevice("d1")->isStale() && node->findDevice("d2")->isStale());
+
+    statistics = context.statistics.read();
+    EXPECT(statistics.onlineNodes == 0 && statistics.onlineDevices == 0);
+    EXPECT(statistics.staleNodes == 1 && statistics.staleDevices == 2);
+
+    std::vector<PublishableUpdate> updates;
+    group.appendTo(updates);
+    EXPECT(updates.size() == 3);
+    for (auto &update : updates)
+    {
+        EXPECT(update.type == UpdateType::DEATH);
+    }
+    releaseUpdates(updates);
+
+    // A new session only revives the Devices that are birthed in it
+    birth(group, 6, {"d1"});
+    EXPECT(!node->isStale());
+    EXPECT(!node->findDevice("d1")->isStale() && node->findDevice("d2")->isStale());
+
+    statistics = context.statistics.read();
+    EXPECT(statistics.onlineNodes == 1 && statistics.onlineDevices == 1);
+}
+
+/**
+ * @brief A death carrying the bdSeq of an earlier session is ignored
+ *
+ */
+static void earlierSession()
+{
+    ModelContext context;
+    Group group("G", &context);
+    birth(group, 5, {"d1"});
+
+    Node *node = group.find("G/n");
+    uint64_t version = context.version;
+
+    EXPECT(send(group, "spBv1.0/G/NDEATH/n", createDeath(4)) == ParseResult::OK);
+
+    EXPECT(!node->isStale() && !node->findDevice("d1")->isStale());
+    EXPECT(context.version == version);
+
+    auto statistics = context.statistics.read();
+    EXPECT(statistics.onlineNodes == 1 && statistics.onlineDevices == 1);
+
+    // The session continues, its data is still applied in sequence
+    tahu::Payload *data = createPayload(true, 2);
+    addLong(data, "value", 2);
+    EXPECT(send(group, "spBv1.0/G/DDATA/n/d1", data) == ParseResult::OK);
+}
+
+int main()
+{
+    cascade();
+    earlierSession();
+
+    return failures;
+}
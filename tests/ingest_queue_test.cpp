@@ -0,0 +1,130 @@
+/*
+ * File: ingest_queue_test.cpp
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#include "Expect.h"
+#include "utilities/IngestQueue.h"
+#include <string>
+#include <vector>
+
+static std::vector<std::string> drain(IngestQueue &queue)
+{
+    std::vector<std::string> topics;
+    IngestEntry entry;
+
+    while (queue.pop(entry))
+    {
+        topics.push_back(entry.message->get_topic());
+    }
+
+    return topics;
+}
+
+/**
+ * @brief A lifecycle message overtakes the data of other Nodes that arrived before it, but takes its own Node's
+ * earlier data with it in order
+ *
+ */
+static void overtake()
+{
+    IngestQueue queue;
+
+    for (auto topic : {
+             "spBv1.0/G/NDATA/a",
+             "spBv1.0/G/NDATA/b",
+             "spBv1.0/G/DDATA/b/d",
+             "spBv1.0/G/NDATA/a",
+             "spBv1.0/G/NDEATH/b",
+             "spBv1.0/G/NDATA/a",
+         })
+    {
+        queue.push(mqtt::message::create(topic, "", 0, false), 0);
+    }
+
+    EXPECT(queue.size() == 6);
+
+    std::vector<std::string> expected = {
+        "spBv1.0/G/NDATA/b",
+        "spBv1.0/G/DDATA/b/d",
+        "spBv1.0/G/NDEATH/b",
+        "spBv1.0/G/NDATA/a",
+        "spBv1.0/G/NDATA/a",
+        "spBv1.0/G/NDATA/a",
+    };
+    EXPECT(drain(queue) == expected);
+    EXPECT(queue.size() == 0);
+}
+
+/**
+ * @brief Messages taken ahead of ones that arrived earlier are flagged as promoted
+ *
+ */
+static void promoted()
+{
+    IngestQueue queue;
+    queue.push(mqtt::message::create("spBv1.0/G/NDATA/a", "", 0, false), 1);
+    queue.push(mqtt::message::create("spBv1.0/G/NBIRTH/b", "", 0, false), 2);
+
+    IngestEntry entry;
+    EXPECT(queue.pop(entry) && entry.message->get_topic() == "spBv1.0/G/NBIRTH/b" && entry.promoted && entry.received == 2);
+    EXPECT(queue.pop(entry) && entry.message->get_topic() == "spBv1.0/G/NDATA/a" && !entry.promoted && entry.received == 1);
+    EXPECT(!queue.pop(entry));
+}
+
+/**
+ * @brief Without lifecycle messages, messages leave in the order they arrived
+ *
+ */
+static void arrival()
+{
+    IngestQueue queue;
+    std::vector<std::string> topics = {
+        "spBv1.0/G/NDATA/a",
+        "spBv1.0/G/NDATA/b",
+        "spBv1.0/G/NDATA/a",
+        "spBv1.0/H/DDATA/a/d",
+    };
+
+    for (auto &topic : topics)
+    {
+        queue.push(mqtt::message::create(topic, "", 0, false), 0);
+    }
+
+    EXPECT(drain(queue) == topics);
+}
+
+int main()
+{
+    overtake();
+    promoted();
+    arrival();
+
+    return failures;
+}
@@ -0,0 +1,138 @@
+/*
+ * File: metric_filters_test.cpp
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#include "Expect.h"
+#include "TestPayloads.h"
+
+static bool hasMetric(const PublishableUpdate *update, const char *name)
+{
+    for (size_t i = 0; update && update->payload && i < update->payload->metrics_count; i++)
+    {
+        if (strcmp(update->payload->metrics[i].name, name) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void match()
+{
+    MetricFilters filters;
+    EXPECT(filters.match("G/n", false, "anything", METRIC_DATA_TYPE_INT64) == ALL_SUBSCRIBERS);
+
+    int temperatures = filters.add("G/+//Temp?rature*");
+    int device = filters.add("G/n/d/#", {METRIC_DATA_TYPE_INT32});
+    EXPECT(temperatures == 0 && device == 1);
+
+    EXPECT(filters.match("G/n", false, "Temperature", METRIC_DATA_TYPE_INT64) == 1);
+    EXPECT(filters.match("G/other", false, "Temperature 2", METRIC_DATA_TYPE_INT64) == 1);
+    EXPECT(filters.match("G/n", false, "Pressure", METRIC_DATA_TYPE_INT64) == 0);
+    // Node Metrics have an empty device segment, so Device Metrics don't match it
+    EXPECT(filters.match("G/n/d", true, "Temperature", METRIC_DATA_TYPE_INT64) == 0);
+
+    // The remainder of the filter may span several Metric name segments
+    EXPECT(filters.match("G/n/d", true, "Inputs/Pressure", METRIC_DATA_TYPE_INT32) == 2);
+    EXPECT(filters.match("G/n/d", true, "Inputs/Pressure", METRIC_DATA_TYPE_INT64) == 0);
+
+    filters.remove(temperatures);
+    EXPECT(filters.match("G/n", false, "Temperature", METRIC_DATA_TYPE_INT64) == 0);
+
+    filters.remove(device);
+    EXPECT(filters.empty());
+    EXPECT(filters.match("G/n", false, "Pressure", METRIC_DATA_TYPE_INT64) == ALL_SUBSCRIBERS);
+}
+
+/**
+ * @brief Data for Metrics outside every filter is skipped, so Metrics matched by a new filter start over unknown
+ *
+ */
+static void invalidation()
+{
+    ModelContext context;
+    Group group("G", &context);
+    int first = context.filters.add("G/n//a");
+
+    tahu::Payload *birth = createBirth(1);
+    addLong(birth, "a", 1);
+    addLong(birth, "b", 1);
+    EXPECT(send(group, "spBv1.0/G/NBIRTH/n", birth) == ParseResult::OK);
+
+    Publishable *node = group.find("G/n");
+    Metric *a = node->find("a");
+    Metric *b = node->find("b");
+    EXPECT(a->isSubscribed() && !b->isSubscribed());
+
+    std::vector<PublishableUpdate> updates;
+    group.appendTo(updates);
+    releaseUpdates(updates);
+
+    tahu::Payload *data = createPayload(true, 1);
+    addLong(data, "a", 2);
+    addLong(data, "b", 2);
+    EXPECT(send(group, "spBv1.0/G/NDATA/n", data) == ParseResult::OK);
+
+    ScalarValue scalar;
+    EXPECT(b->getValue().readScalar(scalar) && scalar.intValue == 1);
+
+    int second = context.filters.add("G/n//b");
+    group.subscribe();
+    EXPECT(b->isSubscribed(1ULL << second) && !b->isSubscribed(1ULL << first));
+    EXPECT(!b->getValue().readScalar(scalar));
+
+    // Already subscribed Metrics keep their value
+    EXPECT(a->getValue().readScalar(scalar) && scalar.intValue == 2);
+
+    data = createPayload(true, 2);
+    addLong(data, "a", 3);
+    addLong(data, "b", 2);
+    EXPECT(send(group, "spBv1.0/G/NDATA/n", data) == ParseResult::OK);
+    EXPECT(b->isDirty());
+
+    // Each subscriber only receives the Metrics its filter matches
+    group.appendTo(updates, false, 1ULL << second);
+    const PublishableUpdate *update = findUpdate(updates, "G/n");
+    EXPECT(hasMetric(update, "b") && !hasMetric(update, "a"));
+    releaseUpdates(updates);
+
+    group.appendTo(updates, false, 1ULL << first);
+    update = findUpdate(updates, "G/n");
+    EXPECT(hasMetric(update, "a") && !hasMetric(update, "b"));
+    releaseUpdates(updates);
+}
+
+int main()
+{
+    match();
+    invalidation();
+
+    return failures;
+}
@@ -0,0 +1,117 @@
+/*
+ * File: metric_handles_test.cpp
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#include "Expect.h"
+#include "TestPayloads.h"
+
+static MetricReading readHandle(ModelContext &context, MetricHandle handle)
+{
+    MetricReading reading;
+    context.handles.read(handle, reading);
+    return reading;
+}
+
+/**
+ * @brief Handles follow the values of their Metric and survive rebirths that keep it
+ *
+ */
+static void survival()
+{
+    ModelContext context;
+    Group group("G", &context);
+
+    tahu::Payload *birth = createBirth(1);
+    addLong(birth, "m", 1);
+    EXPECT(send(group, "spBv1.0/G/NBIRTH/n", birth) == ParseResult::OK);
+
+    Publishable *node = group.find("G/n");
+    Metric *metric = node->find("m");
+    MetricHandle handle = context.handles.bind(metric, node);
+    EXPECT(context.handles.bind(metric, node).index == handle.index);
+
+    MetricReading reading = readHandle(context, handle);
+    EXPECT(reading.valid && reading.hasValue && !reading.stale);
+    EXPECT(reading.value.intValue == 1);
+
+    tahu::Payload *data = createPayload(true, 1);
+    addLong(data, "m", 2);
+    EXPECT(send(group, "spBv1.0/G/NDATA/n", data) == ParseResult::OK);
+    EXPECT(readHandle(context, handle).value.intValue == 2);
+
+    birth = createBirth(2);
+    addLong(birth, "m", 3);
+    EXPECT(send(group, "spBv1.0/G/NBIRTH/n", birth) == ParseResult::OK);
+    EXPECT(context.handles.find(handle) == node->find("m"));
+    reading = readHandle(context, handle);
+    EXPECT(reading.valid && reading.value.intValue == 3);
+
+    EXPECT(send(group, "spBv1.0/G/NDEATH/n", createDeath(2)) == ParseResult::OK);
+    reading = readHandle(context, handle);
+    EXPECT(reading.valid && reading.stale);
+}
+
+/**
+ * @brief Handles of removed Metrics are invalidated, even once their slot is reused by another Metric
+ *
+ */
+static void invalidation()
+{
+    ModelContext context;
+    Group group("G", &context);
+
+    tahu::Payload *birth = createBirth(1);
+    addLong(birth, "removed", 1);
+    EXPECT(send(group, "spBv1.0/G/NBIRTH/n", birth) == ParseResult::OK);
+
+    Publishable *node = group.find("G/n");
+    MetricHandle handle = context.handles.bind(node->find("removed"), node);
+
+    birth = createBirth(2);
+    addLong(birth, "added", 2);
+    EXPECT(send(group, "spBv1.0/G/NBIRTH/n", birth) == ParseResult::OK);
+
+    EXPECT(context.handles.find(handle) == nullptr);
+    EXPECT(!readHandle(context, handle).valid);
+
+    MetricHandle reused = context.handles.bind(node->find("added"), node);
+    EXPECT(reused.index == handle.index && reused.generation != handle.generation);
+    EXPECT(context.handles.find(handle) == nullptr);
+    EXPECT(readHandle(context, reused).value.intValue == 2);
+
+    EXPECT(context.handles.find(MetricHandle()) == nullptr);
+}
+
+int main()
+{
+    survival();
+    invalidation();
+    return failures;
+}
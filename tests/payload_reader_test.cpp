@@ -0,0 +1,239 @@
+/*
+ * File: payload_reader_test.cpp
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#include "Expect.h"
+#include "TestPayloads.h"
+#include <vector>
+
+/**
+ * @brief Writes protobuf fields, enough to encode Payloads of named Int64 Metrics
+ *
+ */
+struct Encoder
+{
+    std::vector<uint8_t> bytes;
+
+    void varint(uint64_t value)
+    {
+        do
+        {
+            uint8_t byte = value & 0x7f;
+            value >>= 7;
+            bytes.push_back(value ? byte | 0x80 : byte);
+        } while (value);
+    }
+
+    void field(uint32_t tag, uint64_t value)
+    {
+        varint((tag << 3) | PB_WT_VARINT);
+        varint(value);
+    }
+
+    void field(uint32_t tag, const uint8_t *data, size_t size)
+    {
+        varint((tag << 3) | PB_WT_STRING);
+        varint(size);
+        bytes.insert(bytes.end(), data, data + size);
+    }
+
+    void field(uint32_t tag, const char *value)
+    {
+        field(tag, (const uint8_t *)value, strlen(value));
+    }
+
+    void field(uint32_t tag, const Encoder &nested)
+    {
+        field(tag, nested.bytes.data(), nested.bytes.size());
+    }
+};
+
+static Encoder encodeMetric(const char *name, int64_t value, uint64_t timestamp)
+{
+    Encoder metric;
+    metric.field(org_eclipse_tahu_protobuf_Payload_Metric_name_tag, name);
+    metric.field(org_eclipse_tahu_protobuf_Payload_Metric_timestamp_tag, timestamp);
+    metric.field(org_eclipse_tahu_protobuf_Payload_Metric_datatype_tag, METRIC_DATA_TYPE_INT64);
+    metric.field(org_eclipse_tahu_protobuf_Payload_Metric_long_value_tag, (uint64_t)value);
+    return metric;
+}
+
+static Encoder encodePayload(uint64_t seq, const std::vector<Encoder> &metrics)
+{
+    Encoder payload;
+    payload.field(org_eclipse_tahu_protobuf_Payload_timestamp_tag, 1);
+    for (auto &metric : metrics)
+    {
+        payload.field(org_eclipse_tahu_protobuf_Payload_metrics_tag, metric);
+    }
+    payload.field(org_eclipse_tahu_protobuf_Payload_seq_tag, seq);
+    return payload;
+}
+
+static uint64_t digestOf(const Encoder &encoded)
+{
+    PayloadReader reader(encoded.bytes.data(), encoded.bytes.size());
+    uint64_t digest = 0;
+    reader.each([&digest](MetricHeader &header)
+                {
+                    digest = header.digest;
+                    return false; },
+                [](tahu::Metric *, MetricHeader &)
+                { return true; });
+    return digest;
+}
+
+/**
+ * @brief Applies an encoded data message the way the host does, decoding only its header up front
+ *
+ */
+static ParseResult sendEncoded(Group &group, std::string topicName, const Encoder &encoded)
+{
+    SparkplugTopic topic;
+    topic.parse(topicName);
+
+    PayloadReader reader(encoded.bytes.data(), encoded.bytes.size());
+    tahu::Payload *payload = createPayload(false, 0);
+    EXPECT(reader.header(payload));
+    EXPECT(reader.index());
+
+    ParseResult result = group.process(topic, payload, &reader);
+    releasePayload(payload);
+    return result;
+}
+
+static void header()
+{
+    Encoder encoded = encodePayload(3, {encodeMetric("a", 1, 10), encodeMetric("b", 2, 20)});
+    PayloadReader reader(encoded.bytes.data(), encoded.bytes.size());
+
+    tahu::Payload payload;
+    memset(&payload, 0, sizeof(payload));
+    EXPECT(reader.header(&payload));
+    EXPECT(payload.has_timestamp && payload.timestamp == 1);
+    EXPECT(payload.has_seq && payload.seq == 3);
+    EXPECT(payload.metrics_count == 0);
+    EXPECT(reader.count() == 2);
+
+    // Headers are read once by index, each walks the index
+    EXPECT(reader.index());
+    std::vector<std::string> names;
+    std::vector<int64_t> values;
+    EXPECT(reader.each([&names](MetricHeader &header)
+                       {
+                           names.push_back(header.name);
+                           return header.name == "b"; },
+                       [&values](tahu::Metric *metric, MetricHeader &header)
+                       {
+                           EXPECT(header.hasTimestamp && header.timestamp == 20);
+                           values.push_back(metric->value.long_value);
+                           return true; }));
+    EXPECT(names.size() == 2 && names[0] == "a" && names[1] == "b");
+    EXPECT(values.size() == 1 && values[0] == 2);
+    EXPECT(reader.count() == 2);
+}
+
+static void digest()
+{
+    // Timestamps are left out of the digest, values aren't
+    uint64_t first = digestOf(encodePayload(0, {encodeMetric("a", 1, 10)}));
+    EXPECT(first == digestOf(encodePayload(0, {encodeMetric("a", 1, 11)})));
+    EXPECT(first != digestOf(encodePayload(0, {encodeMetric("a", 2, 10)})));
+}
+
+/**
+ * @brief Metrics before a malformed Metric are still applied, and the walk reports the Payload as malformed
+ *
+ */
+static void malformed()
+{
+    Encoder encoded = encodePayload(0, {encodeMetric("a", 1, 10), encodeMetric("b", 2, 20)});
+    encoded.bytes.resize(encoded.bytes.size() - 4);
+
+    PayloadReader reader(encoded.bytes.data(), encoded.bytes.size());
+    size_t applied = 0;
+    EXPECT(!reader.each([](MetricHeader &)
+                        { return true; },
+                        [&applied](tahu::Metric *, MetricHeader &)
+                        {
+                            applied++;
+                            return true; }));
+    EXPECT(applied == 1);
+}
+
+/**
+ * @brief Republished Metrics with the same digest only update their timestamp
+ *
+ */
+static void skip()
+{
+    ModelContext context;
+    Group group("G", &context);
+
+    tahu::Payload *birth = createBirth(1);
+    addLong(birth, "value", 0);
+    EXPECT(send(group, "spBv1.0/G/NBIRTH/n", birth) == ParseResult::OK);
+    Metric *metric = ((Publishable *)group.find("G/n"))->find("value");
+
+    EXPECT(sendEncoded(group, "spBv1.0/G/NDATA/n", encodePayload(1, {encodeMetric("value", 5, 10)})) == ParseResult::OK);
+    uint64_t version = context.version;
+    EXPECT(metric->getVersion() == version);
+    EXPECT(metric->getTimestamp() == 10);
+
+    EXPECT(sendEncoded(group, "spBv1.0/G/NDATA/n", encodePayload(2, {encodeMetric("value", 5, 11)})) == ParseResult::OK);
+    EXPECT(context.version == version);
+    EXPECT(metric->getTimestamp() == 11);
+
+    // The digest matches without decoding the Metric
+    Encoder republished = encodePayload(4, {encodeMetric("value", 5, 13)});
+    PayloadReader reader(republished.bytes.data(), republished.bytes.size());
+    EXPECT(reader.each([metric](MetricHeader &header)
+                       {
+                           EXPECT(metric->unchanged(header));
+                           return false; },
+                       [](tahu::Metric *, MetricHeader &)
+                       { return true; }));
+    EXPECT(metric->getTimestamp() == 13);
+
+    EXPECT(sendEncoded(group, "spBv1.0/G/NDATA/n", encodePayload(3, {encodeMetric("value", 6, 12)})) == ParseResult::OK);
+    EXPECT(context.version > version);
+    ScalarValue scalar;
+    EXPECT(metric->getValue().readScalar(scalar) && scalar.intValue == 6);
+}
+
+int main()
+{
+    header();
+    digest();
+    malformed();
+    skip();
+
+    return failures;
+}
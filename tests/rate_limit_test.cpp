@@ -0,0 +1,210 @@
+/*
+ * File: rate_limit_test.cpp
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#include "Expect.h"
+#include "TestPayloads.h"
+
+#define SECOND_US 1000000
+
+static void limitNode(ModelContext &context, RateLimit limit)
+{
+    context.nodeLimits["G/n"] = limit;
+    context.limitRevision++;
+}
+
+static int64_t valueOf(Group &group, const char *metric)
+{
+    ScalarValue scalar;
+    scalar.intValue = -1;
+    ((Publishable *)group.find("G/n"))->find(metric)->getValue().readScalar(scalar);
+    return scalar.intValue;
+}
+
+static tahu::Payload *createData(uint64_t seq, int64_t value)
+{
+    tahu::Payload *payload = createPayload(true, seq);
+    addLong(payload, "value", value);
+    return payload;
+}
+
+static void birth(Group &group)
+{
+    tahu::Payload *payload = createBirth(1);
+    addLong(payload, "value", 0);
+    addLong(payload, "other", 0);
+    EXPECT(send(group, "spBv1.0/G/NBIRTH/n", payload) == ParseResult::OK);
+}
+
+/**
+ * @brief Messages over the limit are discarded and counted
+ *
+ */
+static void drop()
+{
+    ModelContext context;
+    Group group("G", &context);
+    limitNode(context, {1, 0, LimitPolicy::DROP});
+    birth(group);
+
+    EXPECT(send(group, "spBv1.0/G/NDATA/n", createData(1, 1)) == ParseResult::OK);
+    EXPECT(send(group, "spBv1.0/G/NDATA/n", createData(2, 2)) == ParseResult::OK);
+    EXPECT(valueOf(group, "value") == 1);
+
+    auto statistics = context.statistics.read();
+    EXPECT(statistics.limitedMessages == 1 && statistics.droppedMessages == 1);
+
+    context.now += SECOND_US;
+    EXPECT(send(group, "spBv1.0/G/NDATA/n", createData(3, 3)) == ParseResult::OK);
+    EXPECT(valueOf(group, "value") == 3);
+}
+
+/**
+ * @brief Messages over the limit are held and applied in order as tokens are earned
+ *
+ */
+static void defer()
+{
+    ModelContext context;
+    Group group("G", &context);
+    limitNode(context, {1, 0, LimitPolicy::DEFER});
+    birth(group);
+    Node *node = group.find("G/n");
+
+    EXPECT(send(group, "spBv1.0/G/NDATA/n", createData(1, 1)) == ParseResult::OK);
+    EXPECT(send(group, "spBv1.0/G/NDATA/n", createData(2, 2)) == ParseResult::LIMITED);
+    EXPECT(send(group, "spBv1.0/G/NDATA/n", createData(3, 3)) == ParseResult::LIMITED);
+
+    node->release();
+    EXPECT(valueOf(group, "value") == 1);
+
+    context.now += SECOND_US;
+    node->release();
+    EXPECT(valueOf(group, "value") == 2);
+
+    context.now += SECOND_US;
+    node->release();
+    EXPECT(valueOf(group, "value") == 3);
+
+    // Births apply anything still held first, so nothing is lost or reordered
+    EXPECT(send(group, "spBv1.0/G/NDATA/n", createData(4, 4)) == ParseResult::LIMITED);
+    birth(group);
+    EXPECT(valueOf(group, "value") == 0);
+    EXPECT(context.statistics.read().droppedMessages == 0);
+}
+
+/**
+ * @brief Held messages are applied together with only the last value of each Metric, and each message is charged
+ *
+ */
+static void coalesce()
+{
+    ModelContext context;
+    Group group("G", &context);
+    limitNode(context, {1, 0, LimitPolicy::COALESCE});
+    birth(group);
+    Node *node = group.find("G/n");
+
+    EXPECT(send(group, "spBv1.0/G/NDATA/n", createData(1, 1)) == ParseResult::OK);
+
+    tahu::Payload *payload = createData(2, 2);
+    addLong(payload, "other", 20);
+    EXPECT(send(group, "spBv1.0/G/NDATA/n", payload) == ParseResult::LIMITED);
+    EXPECT(send(group, "spBv1.0/G/NDATA/n", createData(3, 3)) == ParseResult::LIMITED);
+
+    node->release();
+    EXPECT(valueOf(group, "value") == 1);
+
+    context.now += SECOND_US;
+    node->release();
+    EXPECT(valueOf(group, "value") == 3);
+    EXPECT(valueOf(group, "other") == 20);
+
+    // Both held messages were charged, so the bucket is a token short a second later
+    EXPECT(send(group, "spBv1.0/G/NDATA/n", createData(4, 4)) == ParseResult::LIMITED);
+    context.now += SECOND_US;
+    node->release();
+    EXPECT(valueOf(group, "value") == 3);
+
+    context.now += SECOND_US;
+    node->release();
+    EXPECT(valueOf(group, "value") == 4);
+}
+
+/**
+ * @brief A coalesced backlog waits for the Metric tokens of its messages, and is charged for the Metrics applied
+ *
+ */
+static void coalesceMetrics()
+{
+    ModelContext context;
+    Group group("G", &context);
+    limitNode(context, {0, 4, LimitPolicy::COALESCE});
+    birth(group);
+    Node *node = group.find("G/n");
+
+    tahu::Payload *payload = createData(1, 1);
+    addLong(payload, "other", 1);
+    addLong(payload, "value", 1);
+    addLong(payload, "other", 1);
+    EXPECT(send(group, "spBv1.0/G/NDATA/n", payload) == ParseResult::OK);
+
+    payload = createData(2, 2);
+    addLong(payload, "other", 2);
+    EXPECT(send(group, "spBv1.0/G/NDATA/n", payload) == ParseResult::LIMITED);
+    payload = createData(3, 3);
+    addLong(payload, "other", 3);
+    EXPECT(send(group, "spBv1.0/G/NDATA/n", payload) == ParseResult::LIMITED);
+
+    // A single token isn't enough for the four Metrics held
+    context.now += SECOND_US / 4;
+    node->release();
+    EXPECT(valueOf(group, "value") == 1);
+
+    context.now += SECOND_US;
+    node->release();
+    EXPECT(valueOf(group, "value") == 3 && valueOf(group, "other") == 3);
+
+    // Only the two Metrics applied were charged, leaving enough for another message of two
+    payload = createData(4, 4);
+    addLong(payload, "other", 4);
+    EXPECT(send(group, "spBv1.0/G/NDATA/n", payload) == ParseResult::OK);
+    EXPECT(send(group, "spBv1.0/G/NDATA/n", createData(5, 5)) == ParseResult::LIMITED);
+}
+
+int main()
+{
+    drop();
+    defer();
+    coalesce();
+    coalesceMetrics();
+
+    return failures;
+}
@@ -0,0 +1,187 @@
+/*
+ * File: snapshot_test.cpp
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#include "Expect.h"
+#include "TestPayloads.h"
+#include "utilities/Snapshot.h"
+#include <cstdio>
+
+#define SNAPSHOT_PATH "snapshot_test.snapshot"
+
+/**
+ * @brief Restores every record of a snapshot into a Group, the way SparkplugHost::loadSnapshot does
+ *
+ */
+static size_t restore(Group &group, const char *path)
+{
+    SnapshotReader reader;
+    if (!reader.open(path))
+    {
+        return 0;
+    }
+
+    SnapshotRecord record;
+    size_t restored = 0;
+
+    while (reader.next(record))
+    {
+        size_t nodeStart = record.name.find('/');
+        size_t deviceStart = record.name.find('/', nodeStart + 1);
+        std::string node = record.name.substr(nodeStart + 1, deviceStart == std::string::npos ? std::string::npos : deviceStart - nodeStart - 1);
+        std::string device = deviceStart == std::string::npos ? "" : record.name.substr(deviceStart + 1);
+
+        tahu::Payload payload;
+        memset(&payload, 0, sizeof(payload));
+        EXPECT(decode_payload(&payload, record.payload, record.length) >= 0);
+        group.restore(node, device, &payload);
+        free_payload(&payload);
+        restored++;
+    }
+
+    return restored;
+}
+
+static int64_t valueOf(Publishable *publisher, const char *metric)
+{
+    ScalarValue scalar;
+    scalar.intValue = -1;
+    Metric *target = publisher ? publisher->find(metric) : nullptr;
+    if (target)
+    {
+        target->getValue().readScalar(scalar);
+    }
+    return scalar.intValue;
+}
+
+static void write()
+{
+    ModelContext context;
+    Group group("G", &context);
+
+    tahu::Payload *birth = createBirth(5);
+    addLong(birth, "value", 7);
+    EXPECT(send(group, "spBv1.0/G/NBIRTH/n", birth) == ParseResult::OK);
+
+    birth = createPayload(true, 1);
+    addInt(birth, "x", 3);
+    EXPECT(send(group, "spBv1.0/G/DBIRTH/n/d", birth) == ParseResult::OK);
+
+    // Dead Publishers aren't written
+    EXPECT(send(group, "spBv1.0/G/NBIRTH/dead", createBirth(1)) == ParseResult::OK);
+    EXPECT(send(group, "spBv1.0/G/NDEATH/dead", createDeath(1)) == ParseResult::OK);
+
+    SnapshotWriter writer;
+    group.snapshot(writer);
+    EXPECT(writer.write(SNAPSHOT_PATH));
+}
+
+/**
+ * @brief Restored Publishers have their last values but wait for a birth before applying data
+ *
+ */
+static void roundTrip()
+{
+    ModelContext context;
+    Group group("G", &context);
+    EXPECT(restore(group, SNAPSHOT_PATH) == 2);
+
+    Node *node = group.find("G/n");
+    EXPECT(node && node->isStale());
+    EXPECT(valueOf(node, "value") == 7);
+    EXPECT(valueOf(node, "bdSeq") == 5);
+    EXPECT(node && valueOf(node->findDevice("d"), "x") == 3);
+    EXPECT(!group.find("G/dead"));
+
+    std::vector<PublishableUpdate> updates;
+    group.appendTo(updates);
+    const PublishableUpdate *update = findUpdate(updates, "G/n");
+    EXPECT(update && update->type == UpdateType::RESTORED);
+    update = findUpdate(updates, "G/n/d");
+    EXPECT(update && update->type == UpdateType::RESTORED);
+    releaseUpdates(updates);
+
+    // The restored session may have ended while the host was down, so data requests a rebirth
+    tahu::Payload *data = createPayload(true, 1);
+    addLong(data, "value", 8);
+    EXPECT(send(group, "spBv1.0/G/NDATA/n", data) == ParseResult::OUT_OF_SYNC);
+    EXPECT(valueOf(node, "value") == 7);
+
+    tahu::Payload *birth = createBirth(6);
+    addLong(birth, "value", 9);
+    EXPECT(send(group, "spBv1.0/G/NBIRTH/n", birth) == ParseResult::OK);
+    EXPECT(!node->isStale());
+    EXPECT(valueOf(node, "value") == 9);
+}
+
+/**
+ * @brief A death with the restored bdSeq ends the restored session, deaths from other sessions don't
+ *
+ */
+static void restoredDeath()
+{
+    ModelContext context;
+    Group group("G", &context);
+    EXPECT(restore(group, SNAPSHOT_PATH) == 2);
+    Node *node = group.find("G/n");
+
+    std::vector<PublishableUpdate> updates;
+    group.appendTo(updates);
+    releaseUpdates(updates);
+
+    uint64_t version = context.version;
+    EXPECT(send(group, "spBv1.0/G/NDEATH/n", createDeath(4)) == ParseResult::OK);
+    EXPECT(context.version == version);
+
+    EXPECT(send(group, "spBv1.0/G/NDEATH/n", createDeath(5)) == ParseResult::OK);
+    EXPECT(!node->isAlive());
+}
+
+static void invalid()
+{
+    FILE *file = fopen(SNAPSHOT_PATH, "wb");
+    fputs("not a snapshot", file);
+    fclose(file);
+
+    SnapshotReader reader;
+    EXPECT(!reader.open(SNAPSHOT_PATH));
+    EXPECT(!reader.open("missing.snapshot"));
+}
+
+int main()
+{
+    write();
+    roundTrip();
+    restoredDeath();
+    invalid();
+    remove(SNAPSHOT_PATH);
+
+    return failures;
+}
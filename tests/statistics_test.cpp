@@ -0,0 +1,116 @@
+/*
+ * File: statistics_test.cpp
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#include "Expect.h"
+#include "TestPayloads.h"
+
+/**
+ * @brief Groups count their Nodes, Devices and messages, and add them to the statistics of the context
+ *
+ */
+static void counters()
+{
+    ModelContext context;
+    Group first("A", &context);
+    Group second("B", &context);
+
+    EXPECT(send(first, "spBv1.0/A/NBIRTH/n", createBirth(1)) == ParseResult::OK);
+    tahu::Payload *payload = createPayload(true, 1);
+    addLong(payload, "value", 1);
+    EXPECT(send(first, "spBv1.0/A/DBIRTH/n/d", payload) == ParseResult::OK);
+    EXPECT(send(second, "spBv1.0/B/NBIRTH/n", createBirth(1)) == ParseResult::OK);
+
+    auto statistics = first.getStatistics()->read();
+    EXPECT(statistics.nodes == 1 && statistics.onlineNodes == 1 && statistics.staleNodes == 0);
+    EXPECT(statistics.devices == 1 && statistics.onlineDevices == 1);
+    EXPECT(statistics.messages == 2);
+
+    statistics = context.statistics.read();
+    EXPECT(statistics.nodes == 2 && statistics.onlineNodes == 2);
+    EXPECT(statistics.devices == 1 && statistics.messages == 3);
+
+    EXPECT(send(second, "spBv1.0/B/NDEATH/n", createDeath(1)) == ParseResult::OK);
+    statistics = context.statistics.read();
+    EXPECT(statistics.nodes == 2 && statistics.onlineNodes == 1 && statistics.staleNodes == 1);
+    EXPECT(second.getStatistics()->read().staleNodes == 1);
+    EXPECT(first.getStatistics()->read().staleNodes == 0);
+}
+
+/**
+ * @brief Messages out of sequence are counted as sequence errors
+ *
+ */
+static void sequenceErrors()
+{
+    ModelContext context;
+    Group group("G", &context);
+    EXPECT(send(group, "spBv1.0/G/NBIRTH/n", createBirth(1)) == ParseResult::OK);
+
+    tahu::Payload *payload = createPayload(true, 5);
+    addLong(payload, "value", 1);
+    EXPECT(send(group, "spBv1.0/G/NDATA/n", payload) == ParseResult::OUT_OF_SYNC);
+
+    auto statistics = context.statistics.read();
+    EXPECT(statistics.sequenceErrors == 1);
+    EXPECT(group.getStatistics()->read().sequenceErrors == 1);
+}
+
+/**
+ * @brief The message rate is measured from the messages received since the previous sample
+ *
+ */
+static void messageRate()
+{
+    ModelContext context;
+    Group group("G", &context);
+    EXPECT(send(group, "spBv1.0/G/NBIRTH/n", createBirth(1)) == ParseResult::OK);
+
+    group.sample(1);
+    for (uint64_t seq = 1; seq <= 4; seq++)
+    {
+        tahu::Payload *payload = createPayload(true, seq);
+        addLong(payload, "value", seq);
+        EXPECT(send(group, "spBv1.0/G/NDATA/n", payload) == ParseResult::OK);
+    }
+
+    group.sample(2);
+    EXPECT(group.getStatistics()->read().messageRate == 2);
+    group.sample(1);
+    EXPECT(group.getStatistics()->read().messageRate == 0);
+}
+
+int main()
+{
+    counters();
+    sequenceErrors();
+    messageRate();
+    return failures;
+}
@@ -0,0 +1,186 @@
+/*
+ * File: template_test.cpp
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#include "Expect.h"
+#include "TestPayloads.h"
+#include "types/Template.h"
+
+/**
+ * @brief Appends a Template Metric to a payload, a definition or an instance of a definition
+ *
+ * @return tahu::Template* The Template value, valid until the next Metric is added
+ */
+static tahu::Template *addTemplate(tahu::Payload *payload, const char *name, const char *reference, bool definition)
+{
+    tahu::Metric *metric = addMetric(payload, name, METRIC_DATA_TYPE_TEMPLATE);
+    metric->which_value = org_eclipse_tahu_protobuf_Payload_Metric_template_value_tag;
+    tahu::Template *value = &metric->value.template_value;
+    value->has_is_definition = true;
+    value->is_definition = definition;
+    value->template_ref = reference ? strdup(reference) : nullptr;
+    return value;
+}
+
+static void addMember(tahu::Template *value, const char *name, int64_t member)
+{
+    value->metrics = (tahu::Metric *)realloc(value->metrics, (value->metrics_count + 1) * sizeof(tahu::Metric));
+    tahu::Metric *metric = &value->metrics[value->metrics_count++];
+    memset(metric, 0, sizeof(tahu::Metric));
+    metric->name = strdup(name);
+    metric->has_datatype = true;
+    metric->datatype = METRIC_DATA_TYPE_INT64;
+    metric->which_value = org_eclipse_tahu_protobuf_Payload_Metric_long_value_tag;
+    metric->value.long_value = member;
+}
+
+static int64_t memberOf(Publishable *publisher, const char *metric, const char *member)
+{
+    TemplateInstance *instance = publisher->find(metric)->getValue().getTemplate();
+    if (!instance)
+    {
+        return -1;
+    }
+
+    int position = instance->getDefinition().indexOf(member);
+    ScalarValue scalar;
+    if (position < 0 || !instance->getMember(position).readScalar(scalar))
+    {
+        return -1;
+    }
+    return scalar.intValue;
+}
+
+static tahu::Payload *createMotorBirth()
+{
+    tahu::Payload *birth = createBirth(1);
+    tahu::Template *definition = addTemplate(birth, "Motor", nullptr, true);
+    addMember(definition, "speed", 0);
+    addMember(definition, "state", 0);
+
+    tahu::Template *instance = addTemplate(birth, "m1", "Motor", false);
+    addMember(instance, "speed", 10);
+    addMember(instance, "state", 1);
+    return birth;
+}
+
+/**
+ * @brief Instances are created from the birthed definition, and only their changed members are reported
+ *
+ */
+static void instance()
+{
+    ModelContext context;
+    Group group("G", &context);
+    EXPECT(send(group, "spBv1.0/G/NBIRTH/n", createMotorBirth()) == ParseResult::OK);
+
+    Publishable *node = group.find("G/n");
+    EXPECT(!node->find("Motor"));
+    EXPECT(memberOf(node, "m1", "speed") == 10);
+    EXPECT(memberOf(node, "m1", "state") == 1);
+
+    std::vector<PublishableUpdate> updates;
+    group.appendTo(updates);
+    releaseUpdates(updates);
+
+    // Partial updates leave out the reference and the unchanged members
+    tahu::Payload *data = createPayload(true, 1);
+    addMember(addTemplate(data, "m1", nullptr, false), "speed", 20);
+    EXPECT(send(group, "spBv1.0/G/NDATA/n", data) == ParseResult::OK);
+    EXPECT(memberOf(node, "m1", "speed") == 20);
+    EXPECT(memberOf(node, "m1", "state") == 1);
+    EXPECT(node->find("m1")->isDirty());
+
+    group.appendTo(updates);
+    const PublishableUpdate *update = findUpdate(updates, "G/n");
+    EXPECT(update && update->payload->metrics_count == 1);
+    if (update && update->payload->metrics_count == 1)
+    {
+        tahu::Template &value = update->payload->metrics[0].value.template_value;
+        EXPECT(value.metrics_count == 1 && strcmp(value.metrics[0].name, "speed") == 0);
+        EXPECT(strcmp(value.template_ref, "Motor") == 0);
+    }
+    releaseUpdates(updates);
+
+    data = createPayload(true, 2);
+    addMember(addTemplate(data, "m1", nullptr, false), "speed", 20);
+    EXPECT(send(group, "spBv1.0/G/NDATA/n", data) == ParseResult::OK);
+    EXPECT(!node->find("m1")->isDirty());
+}
+
+/**
+ * @brief Devices create instances from the definitions birthed by their Node
+ *
+ */
+static void device()
+{
+    ModelContext context;
+    Group group("G", &context);
+    EXPECT(send(group, "spBv1.0/G/NBIRTH/n", createMotorBirth()) == ParseResult::OK);
+
+    tahu::Payload *birth = createPayload(true, 1);
+    addMember(addTemplate(birth, "m2", "Motor", false), "speed", 30);
+    EXPECT(send(group, "spBv1.0/G/DBIRTH/n/d", birth) == ParseResult::OK);
+
+    Device *device = group.find("G/n")->findDevice("d");
+    EXPECT(memberOf(device, "m2", "speed") == 30);
+    EXPECT(memberOf(device, "m2", "state") == -1);
+}
+
+/**
+ * @brief Instances of a definition that was never birthed stay null, partial updates can't create them
+ *
+ */
+static void unknownDefinition()
+{
+    ModelContext context;
+    Group group("G", &context);
+
+    tahu::Payload *birth = createBirth(1);
+    addMember(addTemplate(birth, "p1", "Pump", false), "flow", 5);
+    EXPECT(send(group, "spBv1.0/G/NBIRTH/n", birth) == ParseResult::OK);
+
+    Publishable *node = group.find("G/n");
+    EXPECT(node->find("p1") && node->find("p1")->getValue().isNull());
+
+    tahu::Payload *data = createPayload(true, 1);
+    addMember(addTemplate(data, "p1", nullptr, false), "flow", 6);
+    EXPECT(send(group, "spBv1.0/G/NDATA/n", data) == ParseResult::OK);
+    EXPECT(memberOf(node, "p1", "flow") == -1);
+}
+
+int main()
+{
+    instance();
+    device();
+    unknownDefinition();
+
+    return failures;
+}
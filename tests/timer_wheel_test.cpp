@@ -0,0 +1,149 @@
+/*
+ * File: timer_wheel_test.cpp
+ * Project: cpp_sparkplug_host
+ * Created Date: Monday October 19th 2026
+ * Author: Kyle Hofer
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Kyle Hofer
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * HISTORY:
+ */
+
+#include "Expect.h"
+#include "utilities/TimerWheel.h"
+#include <map>
+#include <vector>
+
+/**
+ * @brief Timers due on either side of each level boundary fire on exactly their tick, whether the wheel is
+ * advanced one tick at a time or jumps straight past them.
+ *
+ */
+static void cascade(bool stepped)
+{
+    // Started part way through the first level so the boundaries aren't aligned with the start
+    const uint64_t start = TIMER_WHEEL_SLOTS - 10;
+    const std::vector<uint64_t> delays = {
+        1,
+        9,
+        10,
+        11,
+        TIMER_WHEEL_SLOTS - 1,
+        TIMER_WHEEL_SLOTS,
+        TIMER_WHEEL_SLOTS + 1,
+        (1 << (2 * TIMER_WHEEL_BITS)) - 1,
+        1 << (2 * TIMER_WHEEL_BITS),
+        (1 << (2 * TIMER_WHEEL_BITS)) + 1,
+        (1 << (3 * TIMER_WHEEL_BITS)) + 12345,
+    };
+
+    TimerWheel wheel;
+    wheel.advance(start, [](TimerEntry *) {});
+
+    std::vector<TimerEntry> entries(delays.size());
+    for (size_t i = 0; i < delays.size(); i++)
+    {
+        entries[i].owner = &entries[i];
+        wheel.schedule(&entries[i], delays[i]);
+    }
+    EXPECT(wheel.size() == delays.size());
+
+    std::map<TimerEntry *, uint64_t> fired;
+    auto expired = [&](TimerEntry *entry)
+    {
+        EXPECT(!entry->isScheduled());
+        fired[entry] = wheel.getTick();
+    };
+
+    uint64_t end = start + delays.back();
+    if (stepped)
+    {
+        for (uint64_t tick = start + 1; tick <= end; tick++)
+        {
+            wheel.advance(tick, expired);
+        }
+    }
+    else
+    {
+        wheel.advance(end, expired);
+    }
+
+    EXPECT(fired.size() == delays.size());
+    EXPECT(wheel.size() == 0);
+
+    for (size_t i = 0; i < delays.size(); i++)
+    {
+        EXPECT(fired.count(&entries[i]) == 1);
+        EXPECT(fired[&entries[i]] == start + delays[i]);
+    }
+}
+
+/**
+ * @brief Cancelled timers never fire, on any level, and cancelling twice is harmless
+ *
+ */
+static void cancel()
+{
+    TimerWheel wheel;
+    TimerEntry near, far, kept;
+
+    wheel.schedule(&near, 5);
+    wheel.schedule(&far, 3 * TIMER_WHEEL_SLOTS);
+    wheel.schedule(&kept, 3 * TIMER_WHEEL_SLOTS);
+
+    wheel.cancel(&near);
+    wheel.cancel(&far);
+    wheel.cancel(&far);
+
+    EXPECT(!near.isScheduled());
+    EXPECT(!far.isScheduled());
+    EXPECT(kept.isScheduled());
+    EXPECT(wheel.size() == 1);
+
+    std::vector<TimerEntry *> fired;
+    for (uint64_t tick = 1; tick <= 4 * TIMER_WHEEL_SLOTS; tick++)
+    {
+        wheel.advance(tick, [&fired](TimerEntry *entry)
+                      { fired.push_back(entry); });
+    }
+
+    EXPECT(fired.size() == 1 && fired[0] == &kept);
+    EXPECT(wheel.size() == 0);
+
+    // Rescheduling replaces the earlier expiry
+    wheel.schedule(&near, 10);
+    wheel.schedule(&near, 2 * TIMER_WHEEL_SLOTS);
+    fired.clear();
+    wheel.advance(wheel.getTick() + 10, [&fired](TimerEntry *entry)
+                  { fired.push_back(entry); });
+    EXPECT(fired.empty() && near.isScheduled());
+}
+
+int main()
+{
+    cascade(true);
+    cascade(false);
+    cancel();
+
+    return failures;
+}